@@ -50,5 +50,5 @@ void HW_Init(void){
 }
 
 void Start_Ticker(void){
-	SysTick_Config(8000);
+	SysTick_Config(OS_CPU_CLOCK_HZ / OMAROS_TICK_RATE_HZ);
 }
@@ -14,11 +14,15 @@
 //----------------------------------------------
 #include "core_cm3.h"
 #include "Platform_Types.h"
+#include "OmarOSConfig.h"
 
 /* Stack Top */
 extern uint32 _estack, _eheap;
 #define MainStackSize 3072
 
+/* SysTick clock (CPU clock), set by HW_Init */
+#define OS_CPU_CLOCK_HZ		8000000UL
+
 //----------------------------------------------
 // Section: Macros definitions
 //----------------------------------------------
@@ -0,0 +1,292 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOSConfig.h 			                             */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+#ifndef INC_OMAROSCONFIG_H_
+#define INC_OMAROSCONFIG_H_
+
+/*
+ * =============================================
+ * OmarOS build configuration
+ * =============================================
+ *
+ * Every switch has a default and can be overridden from the compiler command line (-DMAX_NO_TASKS=8)
+ * or by editing the value here. All kernel tables are sized from these values at compile time.
+ */
+
+//----------------------------------------------
+// Section: Kernel tables
+//----------------------------------------------
+
+/* Tasks the Scheduling Table can hold, the idle task included.
+ * The ready queue is sized to the next power of 2, task indexes grow to 16/32 bits past 255/65535 tasks */
+#ifndef MAX_NO_TASKS
+#define MAX_NO_TASKS				100
+#endif
+
+/* Number of task priorities, 0 is the highest. The lowest one (OMAROS_PRIORITY_LEVELS - 1) is used by the idle task */
+#ifndef OMAROS_PRIORITY_LEVELS
+#define OMAROS_PRIORITY_LEVELS		256
+#endif
+
+/* Scheduling policy:
+ * OMAROS_POLICY_FIXED_PRIORITY: highest priority ready task runs, round robin between equal priorities
+ * OMAROS_POLICY_EDF: earliest absolute deadline runs, deadlines come from Task_Config.RelativeDeadline,
+ *                    tasks without a deadline run in the background in round robin */
+#define OMAROS_POLICY_FIXED_PRIORITY	0
+#define OMAROS_POLICY_EDF				1
+
+#ifndef OMAROS_SCHEDULER_POLICY
+#define OMAROS_SCHEDULER_POLICY		OMAROS_POLICY_FIXED_PRIORITY
+#endif
+
+/* Ticks a task runs before round robin moves to the next task of the same priority,
+ * used when Task_Config.TimeSlice is 0 (1 to 255) */
+#ifndef OMAROS_DEFAULT_TIME_SLICE
+#define OMAROS_DEFAULT_TIME_SLICE	1
+#endif
+
+/* Tasks deleted while running wait in a queue for their stack release, must be a power of 2 */
+#ifndef DELETED_QUEUE_SIZE
+#define DELETED_QUEUE_SIZE			8
+#endif
+
+/* SysTick interrupts per second */
+#ifndef OMAROS_TICK_RATE_HZ
+#define OMAROS_TICK_RATE_HZ			1000
+#endif
+
+/* Idle task stack in bytes */
+#ifndef OMAROS_IDLE_STACK_SIZE
+#define OMAROS_IDLE_STACK_SIZE		300
+#endif
+
+//----------------------------------------------
+// Section: Optional features
+//----------------------------------------------
+
+/* 1: Mutexes with priority ceiling (OmarOS_AcquireMutex/OmarOS_ReleaseMutex) */
+#ifndef OMAROS_USE_MUTEX
+#define OMAROS_USE_MUTEX			1
+#endif
+
+/* 1: Software timers run by a timer service task (OmarOS_Timer.h) */
+#ifndef OMAROS_USE_TIMERS
+#define OMAROS_USE_TIMERS			0
+#endif
+
+/* Timer service task priority and stack, callbacks run on this stack */
+#ifndef OMAROS_TIMER_TASK_PRIORITY
+#define OMAROS_TIMER_TASK_PRIORITY	0
+#endif
+
+#ifndef OMAROS_TIMER_STACK_SIZE
+#define OMAROS_TIMER_STACK_SIZE		512
+#endif
+
+/* 1: Deferred binary logger (OmarOS_Log.h): OMAROS_LOG() stores the format string address and the raw
+ * arguments in a lock free ring buffer, a log task formats them with printf later */
+#ifndef OMAROS_USE_LOG
+#define OMAROS_USE_LOG				0
+#endif
+
+/* Log ring buffer in bytes, must be a power of 2. A record takes 8 bytes plus 4 per argument */
+#ifndef OMAROS_LOG_BUFFER_SIZE
+#define OMAROS_LOG_BUFFER_SIZE		1024
+#endif
+
+/* 1: OmarOS_Init creates a log task that prints the records every OMAROS_LOG_FLUSH_PERIOD ticks
+ * 0: Records are taken with OmarOS_LogRead (sent raw to a host decoder) */
+#ifndef OMAROS_LOG_TASK
+#define OMAROS_LOG_TASK				1
+#endif
+
+/* Log task priority and stack, the stack must be large enough for printf */
+#ifndef OMAROS_LOG_TASK_PRIORITY
+#define OMAROS_LOG_TASK_PRIORITY	(OMAROS_PRIORITY_LEVELS - 2)
+#endif
+
+#ifndef OMAROS_LOG_STACK_SIZE
+#define OMAROS_LOG_STACK_SIZE		1024
+#endif
+
+#ifndef OMAROS_LOG_FLUSH_PERIOD
+#define OMAROS_LOG_FLUSH_PERIOD		10
+#endif
+
+/* 1: Buffered console (OmarOS_Console.h): _write copies into a ring buffer and returns, a console task
+ * sends the bytes with __io_putchar (or OmarOS_ConsoleOutput) when nothing more urgent runs */
+#ifndef OMAROS_USE_CONSOLE
+#define OMAROS_USE_CONSOLE			0
+#endif
+
+/* Console ring buffer in bytes, must be a power of 2 */
+#ifndef OMAROS_CONSOLE_BUFFER_SIZE
+#define OMAROS_CONSOLE_BUFFER_SIZE	512
+#endif
+
+/* What _write does when the console buffer is full:
+ * OMAROS_CONSOLE_BLOCK: the writing task waits a tick at a time until everything is buffered
+ * OMAROS_CONSOLE_DROP: the bytes that don't fit are dropped
+ * OMAROS_CONSOLE_OVERWRITE: the oldest buffered bytes are dropped to make room */
+#define OMAROS_CONSOLE_BLOCK		0
+#define OMAROS_CONSOLE_DROP			1
+#define OMAROS_CONSOLE_OVERWRITE	2
+
+#ifndef OMAROS_CONSOLE_OVERFLOW
+#define OMAROS_CONSOLE_OVERFLOW		OMAROS_CONSOLE_DROP
+#endif
+
+/* Console task priority and stack */
+#ifndef OMAROS_CONSOLE_TASK_PRIORITY
+#define OMAROS_CONSOLE_TASK_PRIORITY	(OMAROS_PRIORITY_LEVELS - 2)
+#endif
+
+#ifndef OMAROS_CONSOLE_STACK_SIZE
+#define OMAROS_CONSOLE_STACK_SIZE	256
+#endif
+
+/* 1: Every task gets its own newlib state (errno, strtok, rand, stdio), PendSV points _impure_ptr at the
+ * next task's struct _reent. Costs sizeof(struct _reent) of RAM per task and one store per switch */
+#ifndef OMAROS_USE_REENT
+#define OMAROS_USE_REENT			0
+#endif
+
+/* 1: Tasks declare a budget per period (Task_Config.Budget/Period). OmarOS_ActivateTask rejects a task
+ * that would push the utilization of the activated tasks over OMAROS_ADMISSION_BOUND, and a task
+ * that used its whole budget is demoted or suspended until its next period */
+#ifndef OMAROS_USE_ADMISSION_CONTROL
+#define OMAROS_USE_ADMISSION_CONTROL	0
+#endif
+
+/* Utilization bound in parts per thousand, 0 = Liu & Layland bound of the admitted task count
+ * (fixed priority with rate monotonic priorities) or 1000 (EDF) */
+#ifndef OMAROS_ADMISSION_BOUND
+#define OMAROS_ADMISSION_BOUND		0
+#endif
+
+/* What happens to a task that used its whole budget before its period ended:
+ * OMAROS_BUDGET_DEMOTE: runs at OMAROS_BUDGET_DEMOTE_PRIORITY (EDF: after the tasks with a deadline)
+ * OMAROS_BUDGET_SUSPEND: doesn't run until its budget is replenished */
+#define OMAROS_BUDGET_DEMOTE			0
+#define OMAROS_BUDGET_SUSPEND			1
+
+#ifndef OMAROS_BUDGET_OVERRUN_ACTION
+#define OMAROS_BUDGET_OVERRUN_ACTION	OMAROS_BUDGET_DEMOTE
+#endif
+
+#ifndef OMAROS_BUDGET_DEMOTE_PRIORITY
+#define OMAROS_BUDGET_DEMOTE_PRIORITY	(OMAROS_PRIORITY_LEVELS - 2)
+#endif
+
+/* 1: Tasks and mutexes keep their name string (Task_Config.TaskName, Mutex_ref.MutexName) for debugging
+ * 0: Only the name hash is kept (OMAROS_TASK_NAME/OMAROS_MUTEX_NAME), lookups by hash work the same */
+#ifndef OMAROS_USE_NAMES
+#define OMAROS_USE_NAMES			1
+#endif
+
+/* 1: Toggle IdleTaskLED/SysTickLED so the scheduler can be watched on a debugger or logic analyzer */
+#ifndef OMAROS_USE_TRACE
+#define OMAROS_USE_TRACE			1
+#endif
+
+/* 1: Keep usage statistics (memory pools and kernel counters) */
+#ifndef OMAROS_USE_STATS
+#define OMAROS_USE_STATS			1
+#endif
+
+/* 1: Measure per task run time and job execution time (Task_ref.Stats), used by Tools/OmarOS_RTA.c.
+ * Costs 24 bytes per task and a SysTick read per context switch */
+#ifndef OMAROS_USE_RUNTIME_STATS
+#define OMAROS_USE_RUNTIME_STATS	0
+#endif
+
+//----------------------------------------------
+// Section: Memory
+//----------------------------------------------
+
+/* 1: Track heap bytes owned by each task and enforce Task_Config.HeapQuota */
+#ifndef HEAP_TASK_QUOTAS
+#define HEAP_TASK_QUOTAS			0
+#endif
+
+/* Second level lists per power of 2 (log2), more lists mean less internal fragmentation but more RAM */
+#ifndef HEAP_SL_INDEX_COUNT_LOG2
+#define HEAP_SL_INDEX_COUNT_LOG2	3
+#endif
+
+/* Blocks (and the managed region) are limited to less than 2^HEAP_FL_INDEX_MAX bytes, 16 KB with 14.
+ * A bigger region is cut at that size, the linker script checks _end to _eheap against OmarOS_HeapMaxSize */
+#ifndef HEAP_FL_INDEX_MAX
+#define HEAP_FL_INDEX_MAX			14
+#endif
+
+/* 1: Allocate/Free using LDREX/STREX, safe from tasks and ISRs
+ * 0: Allocate/Free inside a PRIMASK critical section, for cores without LDREX/STREX. Privileged callers only
+ *    (ISRs, or before OmarOS_StartOS): tasks run unprivileged and can't mask interrupts */
+#ifndef MEMPOOL_LOCK_FREE
+#define MEMPOOL_LOCK_FREE			1
+#endif
+
+/* Maximum RAM (bytes) all static task stacks can take */
+#ifndef OMAROS_STATIC_STACK_BUDGET
+#define OMAROS_STATIC_STACK_BUDGET	8192
+#endif
+
+/* Smallest accepted static stack: the 16 words initial frame plus some room for the task */
+#ifndef OMAROS_STATIC_TASK_MIN_STACK
+#define OMAROS_STATIC_TASK_MIN_STACK	128
+#endif
+
+//----------------------------------------------
+// Section: Derived values (not to be edited)
+//----------------------------------------------
+
+/* Smallest power of 2 that is not less than x (x up to 2^32) */
+#define OMAROS_POW2_ROUND_UP(x)	(OMAROS_POW2_SMEAR((x) - 1UL) + 1UL)
+#define OMAROS_POW2_SMEAR(x)	(OMAROS_POW2_SMEAR8(x) | (OMAROS_POW2_SMEAR8(x) >> 16))
+#define OMAROS_POW2_SMEAR8(x)	(OMAROS_POW2_SMEAR2(x) | (OMAROS_POW2_SMEAR2(x) >> 4) | (OMAROS_POW2_SMEAR2(x) >> 8) | (OMAROS_POW2_SMEAR2(x) >> 12))
+#define OMAROS_POW2_SMEAR2(x)	((x) | ((x) >> 1) | ((x) >> 2) | ((x) >> 3))
+
+/* Every task can be in the ready queue at once */
+#define READY_QUEUE_SIZE		OMAROS_POW2_ROUND_UP(MAX_NO_TASKS)
+
+#define OMAROS_IDLE_PRIORITY	(OMAROS_PRIORITY_LEVELS - 1)
+
+#if (MAX_NO_TASKS < 1)
+#error "MAX_NO_TASKS must leave room for the idle task"
+#endif
+
+#if (OMAROS_PRIORITY_LEVELS < 2) || (OMAROS_PRIORITY_LEVELS > 256)
+#error "OMAROS_PRIORITY_LEVELS must be between 2 and 256 (priorities are stored in 8 bits)"
+#endif
+
+#if (OMAROS_DEFAULT_TIME_SLICE < 1) || (OMAROS_DEFAULT_TIME_SLICE > 255)
+#error "OMAROS_DEFAULT_TIME_SLICE must be between 1 and 255 ticks"
+#endif
+
+#if (OMAROS_ADMISSION_BOUND > 1000)
+#error "OMAROS_ADMISSION_BOUND is in parts per thousand (0 to 1000)"
+#endif
+
+#if (OMAROS_LOG_BUFFER_SIZE < 64) || ((OMAROS_LOG_BUFFER_SIZE & (OMAROS_LOG_BUFFER_SIZE - 1)) != 0)
+#error "OMAROS_LOG_BUFFER_SIZE must be a power of 2 of at least 64 bytes"
+#endif
+
+#if (OMAROS_CONSOLE_BUFFER_SIZE < 16) || ((OMAROS_CONSOLE_BUFFER_SIZE & (OMAROS_CONSOLE_BUFFER_SIZE - 1)) != 0)
+#error "OMAROS_CONSOLE_BUFFER_SIZE must be a power of 2 of at least 16 bytes"
+#endif
+
+#if (HEAP_FL_INDEX_MAX <= (HEAP_SL_INDEX_COUNT_LOG2 + 3)) || (HEAP_FL_INDEX_MAX > 31)
+#error "HEAP_FL_INDEX_MAX must be above HEAP_SL_INDEX_COUNT_LOG2 + 3 and at most 31"
+#endif
+
+#if (DELETED_QUEUE_SIZE == 0) || ((DELETED_QUEUE_SIZE & (DELETED_QUEUE_SIZE - 1)) != 0)
+#error "DELETED_QUEUE_SIZE must be a power of 2"
+#endif
+
+#endif /* INC_OMAROSCONFIG_H_ */
@@ -0,0 +1,83 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_Console.h 			                         */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+#ifndef INC_OMAROS_CONSOLE_H_
+#define INC_OMAROS_CONSOLE_H_
+
+//----------------------------------------------
+// Section: Includes
+//----------------------------------------------
+#include "scheduler.h"
+
+//----------------------------------------------
+// Section: User type definitions
+//----------------------------------------------
+
+/* Console counters, see OmarOS_ConsoleGetStats */
+typedef struct{
+	uint32 Written;			/* Bytes put in the buffer */
+	uint32 Sent;			/* Bytes given to OmarOS_ConsoleOutput by the console task */
+	uint32 Dropped;			/* Bytes lost to a full buffer (OMAROS_CONSOLE_DROP/OVERWRITE) */
+	uint32 Blocked;			/* Ticks writers waited for room (OMAROS_CONSOLE_BLOCK) */
+	uint32 Direct;			/* Bytes sent right away: before OmarOS_StartOS, from ISRs or from the console task */
+	uint32 MaxUsed;			/* Most buffer bytes in use at once */
+}Console_stats;
+
+/*
+ * =============================================
+ * APIs Supported by "OmarOS Buffered Console"
+ * =============================================
+ *
+ * Enabled with OMAROS_USE_CONSOLE. _write (Src/syscalls.c) calls OmarOS_ConsoleWrite, which copies the
+ * bytes into a ring buffer with the scheduler suspended and returns, the calling task never waits for
+ * the UART. A console task at OMAROS_CONSOLE_TASK_PRIORITY takes the bytes out in small chunks and sends
+ * them with OmarOS_ConsoleOutput, then sleeps until the next write. When the buffer is full
+ * OMAROS_CONSOLE_OVERFLOW decides between waiting, dropping the new bytes or dropping the oldest ones.
+ */
+
+/**=============================================
+ * @Fn			- OmarOS_ConsoleWrite
+ * @brief 		- Buffers "Length" bytes for the console task
+ * @param [in] 	- pData: Pointer to the bytes
+ * @param [in] 	- Length: Number of bytes
+ * @retval 		- Length, bytes dropped on overflow are counted in Console_stats.Dropped
+ * Note			- Called by _write. Before OmarOS_StartOS, from ISRs and from the console task itself
+ * 				  the bytes are sent right away with OmarOS_ConsoleOutput
+ */
+int OmarOS_ConsoleWrite(const char* pData, int Length);
+
+/**=============================================
+ * @Fn			- OmarOS_ConsoleOutput
+ * @brief 		- Sends bytes to the console device
+ * @param [in] 	- pData: Pointer to the bytes
+ * @param [in] 	- Length: Number of bytes
+ * @retval 		- None
+ * Note			- Weak, calls __io_putchar for every byte. Can be replaced by a driver that starts a DMA
+ * 				  transfer and waits for its completion interrupt, the console task is the only caller
+ * 				  once the OS runs
+ */
+void OmarOS_ConsoleOutput(const uint8* pData, uint32 Length);
+
+/**=============================================
+ * @Fn			- OmarOS_ConsoleGetStats
+ * @brief 		- Reports the console counters
+ * @param [out] - pStats: Pointer to the structure to be filled
+ * @retval 		- None
+ * Note			- None
+ */
+void OmarOS_ConsoleGetStats(Console_stats* pStats);
+
+/**=============================================
+ * @Fn			- OmarOS_ConsoleInit
+ * @brief 		- Empties the console buffer and creates the console task
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- Called by OmarOS_Init
+ */
+OmarOS_errorTypes OmarOS_ConsoleInit(void);
+
+#endif /* INC_OMAROS_CONSOLE_H_ */
@@ -3,7 +3,7 @@
 /* Project       : OmarOS  	                                             */
 /* File          : OmarOS_FIFO.h 			                             */
 /* Date          : Nov 7, 2023                                           */
-/* Version       : V1                                                    */
+/* Version       : V2                                                    */
 /* GitHub        : https://github.com/Piistachyoo             		     */
 /*************************************************************************/
 #ifndef INC_OMAROS_FIFO_H_
@@ -12,39 +12,142 @@
 //----------------------------------------------
 // Section: Includes
 //----------------------------------------------
-#include "scheduler.h"
+#include "Platform_Types.h"
 
 //----------------------------------------------
 // Section: User type definitions
 //----------------------------------------------
-#define element_type Task_ref*
-
-typedef struct{
-	unsigned int counter;
-	element_type* head;
-	element_type* tail;
-	element_type* base;
-	unsigned int  length;
-}FIFO_Buf_t;
-
 typedef enum{
 	FIFO_NO_ERROR,
 	FIFO_FULL,
 	FIFO_EMPTY,
 	FIFO_NULL,
-
+	FIFO_LENGTH_ERROR
 }Buffer_status;
 
 /*
  * =============================================
- * APIs Supported by "FIFO"
+ * Generic FIFO generator
  * =============================================
+ *
+ * FIFO_DECLARE(prefix, type) declares a FIFO of "type" elements:
+ * 		- prefix##_Buf_t			: FIFO control block
+ * 		- prefix##_init				: Attach a buffer to the FIFO
+ * 		- prefix##_enqueue			: Add one element at the tail
+ * 		- prefix##_dequeue			: Remove one element from the head
+ * 		- prefix##_peek				: Read the head element without removing it
+ * 		- prefix##_enqueue_batch	: Add up to "count" elements, returns the number added
+ * 		- prefix##_dequeue_batch	: Remove up to "count" elements, returns the number removed
+ * 		- prefix##_count			: Number of elements in the FIFO
+ * 		- prefix##_is_full			: Returns FIFO_FULL if no more elements can be added
+ *
+ * FIFO_DEFINE(prefix, type) emits the function bodies, it must be used in exactly one source file.
+ *
+ * Head and tail are free running indexes, the buffer position is obtained by masking them
+ * with (length - 1), so the buffer length must be a power of 2.
  */
+#define FIFO_IS_POWER_OF_2(x)	(((x) != 0) && (((x) & ((x) - 1)) == 0))
+
+#define FIFO_DECLARE(prefix, type)																\
+typedef struct{																					\
+	type*  base;																				\
+	uint32 head;																				\
+	uint32 tail;																				\
+	uint32 mask;																				\
+}prefix##_Buf_t;																				\
+																								\
+Buffer_status prefix##_init (prefix##_Buf_t* fifo, type* buff, uint32 length);					\
+Buffer_status prefix##_enqueue (prefix##_Buf_t* fifo, type item);								\
+Buffer_status prefix##_dequeue (prefix##_Buf_t* fifo, type* item);								\
+Buffer_status prefix##_peek (const prefix##_Buf_t* fifo, type* item);							\
+uint32 prefix##_enqueue_batch (prefix##_Buf_t* fifo, type const* items, uint32 count);			\
+uint32 prefix##_dequeue_batch (prefix##_Buf_t* fifo, type* items, uint32 count);				\
+uint32 prefix##_count (const prefix##_Buf_t* fifo);												\
+Buffer_status prefix##_is_full (const prefix##_Buf_t* fifo)
 
-Buffer_status FIFO_init (FIFO_Buf_t* fifo,element_type* buff , unsigned int length);
-Buffer_status FIFO_enqueue (FIFO_Buf_t* fifo,element_type item);
-Buffer_status FIFO_dequeue (FIFO_Buf_t* fifo,element_type* item);
-Buffer_status FIFO_is_full (FIFO_Buf_t* fifo);
-void FIFO_print (FIFO_Buf_t* fifo);
+#define FIFO_DEFINE(prefix, type)																\
+Buffer_status prefix##_init (prefix##_Buf_t* fifo, type* buff, uint32 length){					\
+	if(!buff)																					\
+		return FIFO_NULL;																		\
+	if(!FIFO_IS_POWER_OF_2(length))																\
+		return FIFO_LENGTH_ERROR;																\
+	fifo->base = buff;																			\
+	fifo->head = 0;																				\
+	fifo->tail = 0;																				\
+	fifo->mask = length - 1;																	\
+	return FIFO_NO_ERROR;																		\
+}																								\
+																								\
+Buffer_status prefix##_enqueue (prefix##_Buf_t* fifo, type item){								\
+	if(!fifo->base)																				\
+		return FIFO_NULL;																		\
+	/* fifo full */																				\
+	if((fifo->tail - fifo->head) > fifo->mask)													\
+		return FIFO_FULL;																		\
+	fifo->base[fifo->tail & fifo->mask] = item;													\
+	fifo->tail++;																				\
+	return FIFO_NO_ERROR;																		\
+}																								\
+																								\
+Buffer_status prefix##_dequeue (prefix##_Buf_t* fifo, type* item){								\
+	if(!fifo->base)																				\
+		return FIFO_NULL;																		\
+	/* fifo empty */																			\
+	if(fifo->head == fifo->tail)																\
+		return FIFO_EMPTY;																		\
+	*item = fifo->base[fifo->head & fifo->mask];												\
+	fifo->head++;																				\
+	return FIFO_NO_ERROR;																		\
+}																								\
+																								\
+Buffer_status prefix##_peek (const prefix##_Buf_t* fifo, type* item){							\
+	if(!fifo->base)																				\
+		return FIFO_NULL;																		\
+	if(fifo->head == fifo->tail)																\
+		return FIFO_EMPTY;																		\
+	*item = fifo->base[fifo->head & fifo->mask];												\
+	return FIFO_NO_ERROR;																		\
+}																								\
+																								\
+uint32 prefix##_enqueue_batch (prefix##_Buf_t* fifo, type const* items, uint32 count){			\
+	uint32 space, index;																		\
+	if(!fifo->base)																				\
+		return 0;																				\
+	space = (fifo->mask + 1) - (fifo->tail - fifo->head);										\
+	if(count > space)																			\
+		count = space;																			\
+	/* Space is checked once for the whole batch */												\
+	for(index = 0; index < count; index++){														\
+		fifo->base[(fifo->tail + index) & fifo->mask] = items[index];							\
+	}																							\
+	fifo->tail += count;																		\
+	return count;																				\
+}																								\
+																								\
+uint32 prefix##_dequeue_batch (prefix##_Buf_t* fifo, type* items, uint32 count){				\
+	uint32 available, index;																	\
+	if(!fifo->base)																				\
+		return 0;																				\
+	available = fifo->tail - fifo->head;														\
+	if(count > available)																		\
+		count = available;																		\
+	for(index = 0; index < count; index++){														\
+		items[index] = fifo->base[(fifo->head + index) & fifo->mask];							\
+	}																							\
+	fifo->head += count;																		\
+	return count;																				\
+}																								\
+																								\
+uint32 prefix##_count (const prefix##_Buf_t* fifo){												\
+	return (fifo->tail - fifo->head);															\
+}																								\
+																								\
+Buffer_status prefix##_is_full (const prefix##_Buf_t* fifo){									\
+	if(!fifo->base)																				\
+		return FIFO_NULL;																		\
+	if((fifo->tail - fifo->head) > fifo->mask)													\
+		return FIFO_FULL;																		\
+	return FIFO_NO_ERROR;																		\
+}
 
 #endif /* INC_OMAROS_FIFO_H_ */
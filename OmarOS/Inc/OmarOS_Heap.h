@@ -0,0 +1,116 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_Heap.h 			                             */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+#ifndef INC_OMAROS_HEAP_H_
+#define INC_OMAROS_HEAP_H_
+
+//----------------------------------------------
+// Section: Includes
+//----------------------------------------------
+#include "scheduler.h"
+
+//----------------------------------------------
+// Section: User type definitions
+//----------------------------------------------
+typedef struct{
+	uint32 TotalSize;			/* Bytes managed by the heap (headers included) */
+	uint32 FreeSize;			/* Bytes in free blocks (headers included) */
+	uint32 MinEverFreeSize;		/* Lowest value FreeSize reached */
+	uint32 LargestFreeBlock;	/* Biggest allocation that can currently succeed */
+	uint32 NoOfFreeBlocks;
+	uint32 NoOfUsedBlocks;
+	uint32 FailedAllocations;
+	uint8  Fragmentation;		/* 0% when all free memory is one block, close to 100% when it is scattered */
+}Heap_stats;
+
+/*
+ * =============================================
+ * APIs Supported by "OmarOS Heap" (Two Level Segregated Fit allocator)
+ * =============================================
+ */
+
+/**=============================================
+ * @Fn			- OmarOS_HeapInit
+ * @brief 		- Hands a memory region to the heap
+ * @param [in] 	- pStart: Start address of the region
+ * @param [in] 	- Size: Size of the region in bytes
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- The newlib malloc family initializes the heap between _end and _eheap on first use
+ * 				  Only the first 2^HEAP_FL_INDEX_MAX bytes of a bigger region are used, see OmarOS_HeapGetStats TotalSize
+ */
+OmarOS_errorTypes OmarOS_HeapInit(void* pStart, uint32 Size);
+
+/**=============================================
+ * @Fn			- OmarOS_HeapAlloc
+ * @brief 		- Allocates a block of at least "Size" bytes in constant time
+ * @param [in] 	- Size: Number of bytes requested
+ * @retval 		- Pointer to 8 bytes aligned memory or NULL if the request can't be satisfied
+ * Note			- Safe to call from different tasks, must not be called from ISRs (use memory pools instead)
+ */
+void* OmarOS_HeapAlloc(uint32 Size);
+
+/**=============================================
+ * @Fn			- OmarOS_HeapAllocAligned
+ * @brief 		- Allocates a block of at least "Size" bytes whose address is a multiple of "Alignment"
+ * @param [in] 	- Alignment: Power of 2, 8 or less gives the same block as OmarOS_HeapAlloc
+ * @param [in] 	- Size: Number of bytes requested
+ * @retval 		- Pointer to the aligned memory or NULL if the request can't be satisfied
+ * Note			- Safe to call from different tasks, must not be called from ISRs
+ * 				  The space in front of the aligned address goes back to the heap as a free block
+ */
+void* OmarOS_HeapAllocAligned(uint32 Alignment, uint32 Size);
+
+/**=============================================
+ * @Fn			- OmarOS_HeapFree
+ * @brief 		- Returns a block to the heap in constant time and merges it with its free neighbours
+ * @param [in] 	- pBlock: Pointer returned by OmarOS_HeapAlloc, NULL is ignored
+ * @retval 		- None
+ * Note			- Safe to call from different tasks, must not be called from ISRs (use memory pools instead)
+ */
+void OmarOS_HeapFree(void* pBlock);
+
+/**=============================================
+ * @Fn			- OmarOS_HeapRealloc
+ * @brief 		- Resizes a block, growing in place when the next block is free
+ * @param [in] 	- pBlock: Pointer returned by OmarOS_HeapAlloc or NULL
+ * @param [in] 	- Size: New size in bytes
+ * @retval 		- Pointer to the resized block, or NULL if the request can't be satisfied or pBlock is not in the heap (pBlock is kept)
+ * Note			- Safe to call from different tasks, must not be called from ISRs
+ */
+void* OmarOS_HeapRealloc(void* pBlock, uint32 Size);
+
+/**=============================================
+ * @Fn			- OmarOS_HeapUsableSize
+ * @brief 		- Returns how many bytes of an allocated block can be used, at least the size requested
+ * @param [in] 	- pBlock: Pointer returned by OmarOS_HeapAlloc, OmarOS_HeapAllocAligned or OmarOS_HeapRealloc
+ * @retval 		- Usable bytes, 0 if pBlock is NULL, not in the heap or free
+ * Note			- None
+ */
+uint32 OmarOS_HeapUsableSize(void* pBlock);
+
+/**=============================================
+ * @Fn			- OmarOS_HeapGetStats
+ * @brief 		- Reports heap usage and fragmentation
+ * @param [out] - pStats: Pointer to the structure to be filled
+ * @retval 		- None
+ * Note			- Walks the free lists, so it is not constant time
+ */
+void OmarOS_HeapGetStats(Heap_stats* pStats);
+
+#if (HEAP_TASK_QUOTAS == 1)
+/**=============================================
+ * @Fn			- OmarOS_HeapReleaseOwner
+ * @brief 		- Detaches the blocks of a deleted task from it, they stay allocated but no longer count against a quota
+ * @param [in] 	- pTask: Pointer to the deleted task
+ * @retval 		- None
+ * Note			- Walks every block, called by the scheduler once a task is deleted (only with HEAP_TASK_QUOTAS)
+ */
+void OmarOS_HeapReleaseOwner(Task_ref* pTask);
+#endif
+
+#endif /* INC_OMAROS_HEAP_H_ */
@@ -0,0 +1,117 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_Log.h 			                             */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+#ifndef INC_OMAROS_LOG_H_
+#define INC_OMAROS_LOG_H_
+
+//----------------------------------------------
+// Section: Includes
+//----------------------------------------------
+#include <stdint.h>
+#include "scheduler.h"
+
+//----------------------------------------------
+// Section: User type definitions
+//----------------------------------------------
+
+/* Most arguments a record can carry */
+#define OMAROS_LOG_MAX_ARGS		4
+
+/* A record taken out of the log buffer */
+typedef struct{
+	const char* Format;						/* Address of the format string, also its ID for a host decoder */
+	uint32 Tick;							/* Low 28 bits of the tick count the record was written at */
+	uint32 NoOfArgs;
+	uintptr_t Args[OMAROS_LOG_MAX_ARGS];
+}Log_record;
+
+/* Logger counters, see OmarOS_LogGetStats */
+typedef struct{
+	uint32 Read;		/* Records taken out by OmarOS_LogRead */
+	uint32 Dropped;		/* Records lost because the buffer was full */
+	uint32 MaxUsed;		/* Most buffer bytes in use at once (OMAROS_USE_STATS) */
+}Log_stats;
+
+/*
+ * =============================================
+ * APIs Supported by "OmarOS Deferred Logger"
+ * =============================================
+ *
+ * Enabled with OMAROS_USE_LOG. OMAROS_LOG(Format, ...) doesn't format anything: it reserves a record in
+ * the ring buffer with one LDREX/STREX, stores the format string address, the tick count and up to
+ * OMAROS_LOG_MAX_ARGS pointer sized arguments, and returns. A record is only visible once its header word is
+ * written, so tasks and ISRs can log at the same time without a lock. The log task (OMAROS_LOG_TASK)
+ * prints the records with printf, one line each, when nothing more urgent runs.
+ *
+ * OMAROS_LOG casts every argument to uintptr_t, so formats may use %d %i %u %x %X %c with int sized
+ * values, %p and %s (the string must still exist when the record is printed, string literals are
+ * fine). Flags, width and precision are kept, %f, %ld, %lld and the like are printed as they are
+ * written. When the buffer is full the record is dropped and counted, the caller never waits.
+ *
+ * 		OMAROS_LOG("adc channel %u = %d", Channel, Value);
+ */
+#define OMAROS_LOG(...)		OMAROS_LOG_SELECT(__VA_ARGS__, OMAROS_LOG4, OMAROS_LOG3, OMAROS_LOG2, OMAROS_LOG1, OMAROS_LOG0, 0)(__VA_ARGS__)
+#define OMAROS_LOG_SELECT(Format, Arg1, Arg2, Arg3, Arg4, Function, ...)	Function
+#define OMAROS_LOG0(Format)							OmarOS_Log0(Format)
+#define OMAROS_LOG1(Format, Arg1)					OmarOS_Log1(Format, (uintptr_t)(Arg1))
+#define OMAROS_LOG2(Format, Arg1, Arg2)				OmarOS_Log2(Format, (uintptr_t)(Arg1), (uintptr_t)(Arg2))
+#define OMAROS_LOG3(Format, Arg1, Arg2, Arg3)		OmarOS_Log3(Format, (uintptr_t)(Arg1), (uintptr_t)(Arg2), (uintptr_t)(Arg3))
+#define OMAROS_LOG4(Format, Arg1, Arg2, Arg3, Arg4)	OmarOS_Log4(Format, (uintptr_t)(Arg1), (uintptr_t)(Arg2), (uintptr_t)(Arg3), (uintptr_t)(Arg4))
+
+/**=============================================
+ * @Fn			- OmarOS_Log0 ... OmarOS_Log4
+ * @brief 		- Stores a record with 0 to 4 arguments, called by OMAROS_LOG
+ * @param [in] 	- Format: Format string, must stay valid (a string literal)
+ * @param [in] 	- Arg1 ... Arg4: Arguments, OMAROS_LOG casts them to uintptr_t
+ * @retval 		- None
+ * Note			- Safe from tasks and ISRs, never blocks
+ */
+void OmarOS_Log0(const char* Format);
+void OmarOS_Log1(const char* Format, uintptr_t Arg1);
+void OmarOS_Log2(const char* Format, uintptr_t Arg1, uintptr_t Arg2);
+void OmarOS_Log3(const char* Format, uintptr_t Arg1, uintptr_t Arg2, uintptr_t Arg3);
+void OmarOS_Log4(const char* Format, uintptr_t Arg1, uintptr_t Arg2, uintptr_t Arg3, uintptr_t Arg4);
+
+/**=============================================
+ * @Fn			- OmarOS_LogRead
+ * @brief 		- Takes the oldest record out of the log buffer
+ * @param [out] - pRecord: Pointer to the record to be filled
+ * @retval 		- Returns 1 if a record was taken, 0 if there was none
+ * Note			- A single reader only (the log task when OMAROS_LOG_TASK is 1)
+ * 				  A record still being written by a preempted task ends the read, it is taken next time
+ */
+uint8 OmarOS_LogRead(Log_record* pRecord);
+
+/**=============================================
+ * @Fn			- OmarOS_LogPrint
+ * @brief 		- Prints a record as one line: the tick count, then the formatted message
+ * @param [in] 	- pRecord: Pointer to a record from OmarOS_LogRead
+ * @retval 		- None
+ * Note			- Uses printf once per conversion with the argument's own type, only called from a task
+ * 				  with a large enough stack
+ */
+void OmarOS_LogPrint(const Log_record* pRecord);
+
+/**=============================================
+ * @Fn			- OmarOS_LogGetStats
+ * @brief 		- Reports how many records were read and dropped, and the buffer high water mark
+ * @param [out] - pStats: Pointer to the structure to be filled
+ * @retval 		- None
+ * Note			- None
+ */
+void OmarOS_LogGetStats(Log_stats* pStats);
+
+/**=============================================
+ * @Fn			- OmarOS_LogInit
+ * @brief 		- Empties the log buffer and creates the log task
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- Called by OmarOS_Init
+ */
+OmarOS_errorTypes OmarOS_LogInit(void);
+
+#endif /* INC_OMAROS_LOG_H_ */
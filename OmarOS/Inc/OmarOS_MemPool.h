@@ -0,0 +1,88 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_MemPool.h 			                         */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+#ifndef INC_OMAROS_MEMPOOL_H_
+#define INC_OMAROS_MEMPOOL_H_
+
+//----------------------------------------------
+// Section: Includes
+//----------------------------------------------
+#include "scheduler.h"
+
+//----------------------------------------------
+// Section: User type definitions
+//----------------------------------------------
+typedef struct MemPool_Block{
+	struct MemPool_Block* pNext; /* Valid only while the block is free */
+}MemPool_Block;
+
+typedef struct{
+	MemPool_Block* volatile pFreeList;	/* Not entered by the user */
+	uint8* pBuffer;						/* Not entered by the user */
+	uint32 BlockSize;					/* Not entered by the user */
+	uint32 NoOfBlocks;					/* Not entered by the user */
+
+#if (OMAROS_USE_STATS == 1)
+	/* Statistics */
+	volatile uint32 UsedBlocks;
+	volatile uint32 HighWaterMark;
+	volatile uint32 FailedAllocations;
+#endif
+}MemPool_ref;
+
+//----------------------------------------------
+// Section: Macros Configuration References
+//----------------------------------------------
+
+/* Block sizes are rounded up to a whole number of words to keep every block aligned */
+#define MEMPOOL_BLOCK_WORDS(BlockSize)	(((BlockSize) + sizeof(uint32) - 1) / sizeof(uint32))
+
+/* Declares a word aligned buffer big enough for "NoOfBlocks" blocks of "BlockSize" bytes */
+#define MEMPOOL_BUFFER(name, BlockSize, NoOfBlocks)	uint32 name[MEMPOOL_BLOCK_WORDS(BlockSize) * (NoOfBlocks)]
+
+/*
+ * =============================================
+ * APIs Supported by "OmarOS Memory Pools"
+ * =============================================
+ */
+
+/**=============================================
+ * @Fn			- OmarOS_MemPoolInit
+ * @brief 		- Splits a buffer into fixed size blocks and links them in the pool's free list
+ * @param [in] 	- pPool: Pointer to the pool object
+ * @param [in] 	- pBuffer: Word aligned buffer, declare it with MEMPOOL_BUFFER
+ * @param [in] 	- BlockSize: Size of one block in bytes
+ * @param [in] 	- NoOfBlocks: Number of blocks in the buffer
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- Must be called before the pool is used by any task or ISR
+ */
+OmarOS_errorTypes OmarOS_MemPoolInit(MemPool_ref* pPool, void* pBuffer, uint32 BlockSize, uint32 NoOfBlocks);
+
+/**=============================================
+ * @Fn			- OmarOS_MemPoolAlloc
+ * @brief 		- Takes one block from the pool in constant time
+ * @param [in] 	- pPool: Pointer to the pool object
+ * @retval 		- Pointer to the allocated block or NULL if the pool is empty
+ * Note			- Can be called from tasks and ISRs with MEMPOOL_LOCK_FREE 1, with 0 only from ISRs and
+ * 				  before OmarOS_StartOS (PRIMASK can't be set by an unprivileged task)
+ */
+void* OmarOS_MemPoolAlloc(MemPool_ref* pPool);
+
+/**=============================================
+ * @Fn			- OmarOS_MemPoolFree
+ * @brief 		- Returns a block to its pool in constant time
+ * @param [in] 	- pPool: Pointer to the pool object
+ * @param [in] 	- pBlock: Pointer returned by OmarOS_MemPoolAlloc
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- Can be called from tasks and ISRs with MEMPOOL_LOCK_FREE 1, with 0 only from ISRs and
+ * 				  before OmarOS_StartOS (PRIMASK can't be set by an unprivileged task).
+ * 				  Freeing the same block twice is not detected
+ */
+OmarOS_errorTypes OmarOS_MemPoolFree(MemPool_ref* pPool, void* pBlock);
+
+#endif /* INC_OMAROS_MEMPOOL_H_ */
@@ -0,0 +1,63 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_NameHash.h 		                             */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+#ifndef INC_OMAROS_NAMEHASH_H_
+#define INC_OMAROS_NAMEHASH_H_
+
+//----------------------------------------------
+// Section: Includes
+//----------------------------------------------
+#include "OmarOSConfig.h"
+#include "Platform_Types.h"
+
+/*
+ * =============================================
+ * Build time name hashing
+ * =============================================
+ *
+ * Tasks and mutexes are looked up by the 32 bits FNV-1a hash of their name instead of comparing strings.
+ * OMAROS_NAME_HASH("name") unrolls FNV-1a over the characters of a string literal, the compiler folds it to
+ * a constant (also at -O0 and in static initializers), so no name is hashed or even stored at run time.
+ * OmarOS_NameHash does the same on a string in RAM, both only hash the first OMAROS_NAME_HASH_MAX_LENGTH
+ * characters so they always agree.
+ *
+ * The result is a constant but not an integer constant expression, it can't be used as a case label.
+ */
+#define OMAROS_NAME_HASH_OFFSET		2166136261UL
+#define OMAROS_NAME_HASH_PRIME		16777619UL
+#define OMAROS_NAME_HASH_MAX_LENGTH	32
+
+/* Character "i" of the literal "s", 0 past its end (the index is clamped so nothing is read out of bounds) */
+#define OMAROS_NAME_HASH_CHAR(s, i)		(((i) < (sizeof(s) - 1)) ? (uint32)(uint8)(s)[((i) < sizeof(s)) ? (i) : 0] : 0UL)
+
+/* One FNV-1a step, past the end of the literal it xors 0 and multiplies by 1. "h" is used once so the
+ * nested expansion grows linearly with the length */
+#define OMAROS_NAME_HASH_STEP(h, s, i)	\
+	((uint32)(((h) ^ OMAROS_NAME_HASH_CHAR(s, i)) * (((i) < (sizeof(s) - 1)) ? OMAROS_NAME_HASH_PRIME : 1UL)))
+
+#define OMAROS_NAME_HASH_4(h, s, i)		\
+	OMAROS_NAME_HASH_STEP(OMAROS_NAME_HASH_STEP(OMAROS_NAME_HASH_STEP(OMAROS_NAME_HASH_STEP(h, s, i), s, (i) + 1), s, (i) + 2), s, (i) + 3)
+#define OMAROS_NAME_HASH_16(h, s, i)	\
+	OMAROS_NAME_HASH_4(OMAROS_NAME_HASH_4(OMAROS_NAME_HASH_4(OMAROS_NAME_HASH_4(h, s, i), s, (i) + 4), s, (i) + 8), s, (i) + 12)
+
+/* Hash of a string literal, equal to OmarOS_NameHash(s) */
+#define OMAROS_NAME_HASH(s)		OMAROS_NAME_HASH_16(OMAROS_NAME_HASH_16(OMAROS_NAME_HASH_OFFSET, "" s, 0), "" s, 16)
+
+/* Names of tasks and mutexes, for designated initializers:
+ * 		static const Task_Config Config = { OMAROS_TASK_NAME("uart"), .pf_TaskEntry = ... };
+ * 		Mutex_ref Mutex = { OMAROS_MUTEX_NAME("bus") };
+ * With OMAROS_USE_NAMES == 0 only the hash is kept, the string never reaches the image */
+#if (OMAROS_USE_NAMES == 1)
+#define OMAROS_TASK_NAME(s)		.TaskName = (s), .NameHash = OMAROS_NAME_HASH(s)
+#define OMAROS_MUTEX_NAME(s)	.MutexName = (s), .NameHash = OMAROS_NAME_HASH(s)
+#else
+#define OMAROS_TASK_NAME(s)		.NameHash = OMAROS_NAME_HASH(s)
+#define OMAROS_MUTEX_NAME(s)	.NameHash = OMAROS_NAME_HASH(s)
+#endif
+
+#endif /* INC_OMAROS_NAMEHASH_H_ */
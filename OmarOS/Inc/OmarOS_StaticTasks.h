@@ -0,0 +1,125 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_StaticTasks.h 			                     */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+#ifndef INC_OMAROS_STATICTASKS_H_
+#define INC_OMAROS_STATICTASKS_H_
+
+//----------------------------------------------
+// Section: Includes
+//----------------------------------------------
+#include "scheduler.h"
+
+/*
+ * =============================================
+ * Static task table
+ * =============================================
+ *
+ * Tasks are listed once in an X-macro that takes two entry forms, TASK(name, entry, priority,
+ * stack_size, autostart) and TASK_EX(name, entry, priority, stack_size, autostart, time_slice,
+ * deadline, budget, period, heap_quota) for the Task_Config fields of the optional features:
+ *
+ * 		#define APP_TASKS(TASK, TASK_EX)													\
+ * 			TASK(Task1, Task_1, 10, 1024, Autostart_Enabled)								\
+ * 			TASK_EX(Task2, Task_2, 8, 1024, Autostart_Disabled, 2, 20, 5, 50, 512)
+ *
+ * 		OMAROS_STATIC_TASKS_DEFINE(APP_TASKS)		-> in exactly one source file
+ * 		OMAROS_STATIC_TASKS_DECLARE(APP_TASKS)		-> where other files need the Task_ref objects
+ *
+ * 		OmarOS_Init();
+ * 		OMAROS_REGISTER_STATIC_TASKS();
+ * 		OmarOS_StartOS();
+ *
+ * Every task gets a Task_ref named "name" whose stack bounds point to a statically sized stack array,
+ * and a const Task_Config kept in flash, so nothing is laid out at boot. Stack sizes, priorities,
+ * the number of tasks and the total stack RAM are checked at build time. Priorities follow the
+ * OmarOS_CreateTask rule: 0 to OMAROS_IDLE_PRIORITY, a task at the idle priority shares it in round robin.
+ *
+ * TASK is TASK_EX with the last five fields 0. They go to Task_Config.TimeSlice, RelativeDeadline,
+ * Budget, Period and HeapQuota, and 0 keeps each default. A field whose feature is disabled
+ * (OMAROS_SCHEDULER_POLICY EDF, OMAROS_USE_ADMISSION_CONTROL, HEAP_TASK_QUOTAS) is not in Task_Config
+ * and is ignored, so one table builds with any switches. A budget larger than its period is rejected
+ * at build time like OmarOS_CreateTask rejects it.
+ */
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+#define OMAROS_STATIC_TASK_DEADLINE(deadline)			.RelativeDeadline = (deadline),
+#else
+#define OMAROS_STATIC_TASK_DEADLINE(deadline)
+#endif
+
+#if (OMAROS_USE_ADMISSION_CONTROL == 1)
+#define OMAROS_STATIC_TASK_BUDGET(budget, period)		.Budget = (budget), .Period = (period),
+#define OMAROS_STATIC_TASK_BUDGET_IS_VALID(budget, period)	(((budget) == 0) || ((budget) <= (period)))
+#else
+#define OMAROS_STATIC_TASK_BUDGET(budget, period)
+#define OMAROS_STATIC_TASK_BUDGET_IS_VALID(budget, period)	1
+#endif
+
+#if (HEAP_TASK_QUOTAS == 1)
+#define OMAROS_STATIC_TASK_QUOTA(heap_quota)			.HeapQuota = (heap_quota),
+#else
+#define OMAROS_STATIC_TASK_QUOTA(heap_quota)
+#endif
+
+#define OMAROS_STATIC_TASK_STACK_EX(name, entry, priority, stack_size, autostart, time_slice, deadline, budget, period, heap_quota)	\
+	static uint32 name##_Stack[(stack_size) / sizeof(uint32)] __attribute__((aligned(8)));							\
+	_Static_assert(((stack_size) % 8) == 0, #name ": stack size must be a multiple of 8 bytes");					\
+	_Static_assert((stack_size) >= OMAROS_STATIC_TASK_MIN_STACK, #name ": stack size is too small");				\
+	_Static_assert(((priority) >= 0) && ((priority) <= OMAROS_IDLE_PRIORITY), #name ": priority is out of range");	\
+	_Static_assert(((time_slice) >= 0) && ((time_slice) <= 255), #name ": time slice is out of range");			\
+	_Static_assert(OMAROS_STATIC_TASK_BUDGET_IS_VALID(budget, period), #name ": budget is larger than its period");
+
+#define OMAROS_STATIC_TASK_OBJECT_EX(name, entry, priority, stack_size, autostart, time_slice, deadline, budget, period, heap_quota)	\
+	static const Task_Config name##_Config = {																		\
+		OMAROS_TASK_NAME(#name),																					\
+		.pf_TaskEntry = entry,																						\
+		.Stack_Size = stack_size,																					\
+		.Priority = priority,																						\
+		.AutoStart = autostart,																						\
+		.TimeSlice = time_slice,																					\
+		OMAROS_STATIC_TASK_DEADLINE(deadline)																		\
+		OMAROS_STATIC_TASK_BUDGET(budget, period)																	\
+		OMAROS_STATIC_TASK_QUOTA(heap_quota)																		\
+	};																												\
+	Task_ref name = {																								\
+		.pConfig = &name##_Config,																					\
+		._S_PSP_Task = (uint32)&name##_Stack[(stack_size) / sizeof(uint32)],										\
+		._E_PSP_Task = (uint32)&name##_Stack[0]																		\
+	};
+
+#define OMAROS_STATIC_TASK_EXTERN_EX(name, entry, priority, stack_size, autostart, time_slice, deadline, budget, period, heap_quota)		\
+	extern Task_ref name;
+#define OMAROS_STATIC_TASK_POINTER_EX(name, entry, priority, stack_size, autostart, time_slice, deadline, budget, period, heap_quota)	\
+	&name,
+#define OMAROS_STATIC_TASK_SIZE_EX(name, entry, priority, stack_size, autostart, time_slice, deadline, budget, period, heap_quota)		\
+	+ (stack_size)
+
+/* TASK entries, the optional fields keep their defaults */
+#define OMAROS_STATIC_TASK_STACK(name, entry, priority, stack_size, autostart)		OMAROS_STATIC_TASK_STACK_EX(name, entry, priority, stack_size, autostart, 0, 0, 0, 0, 0)
+#define OMAROS_STATIC_TASK_OBJECT(name, entry, priority, stack_size, autostart)		OMAROS_STATIC_TASK_OBJECT_EX(name, entry, priority, stack_size, autostart, 0, 0, 0, 0, 0)
+#define OMAROS_STATIC_TASK_EXTERN(name, entry, priority, stack_size, autostart)		extern Task_ref name;
+#define OMAROS_STATIC_TASK_POINTER(name, entry, priority, stack_size, autostart)	&name,
+#define OMAROS_STATIC_TASK_SIZE(name, entry, priority, stack_size, autostart)		+ (stack_size)
+
+#define OMAROS_STATIC_TASKS_DEFINE(TASKS)																			\
+	TASKS(OMAROS_STATIC_TASK_STACK, OMAROS_STATIC_TASK_STACK_EX)													\
+	TASKS(OMAROS_STATIC_TASK_OBJECT, OMAROS_STATIC_TASK_OBJECT_EX)													\
+	Task_ref* const OmarOS_StaticTaskTable[] = { TASKS(OMAROS_STATIC_TASK_POINTER, OMAROS_STATIC_TASK_POINTER_EX) };	\
+	_Static_assert((0 TASKS(OMAROS_STATIC_TASK_SIZE, OMAROS_STATIC_TASK_SIZE_EX)) <= OMAROS_STATIC_STACK_BUDGET,	\
+			"static task stacks exceed OMAROS_STATIC_STACK_BUDGET");												\
+	_Static_assert((sizeof(OmarOS_StaticTaskTable) / sizeof(OmarOS_StaticTaskTable[0])) < MAX_NO_TASKS,			\
+			"too many static tasks, one slot of MAX_NO_TASKS is used by the idle task");
+
+#define OMAROS_STATIC_TASKS_DECLARE(TASKS)																			\
+	TASKS(OMAROS_STATIC_TASK_EXTERN, OMAROS_STATIC_TASK_EXTERN_EX)													\
+	extern Task_ref* const OmarOS_StaticTaskTable[];
+
+/* Walks the generated table, must be used where OMAROS_STATIC_TASKS_DEFINE is visible */
+#define OMAROS_REGISTER_STATIC_TASKS()																				\
+	OmarOS_RegisterStaticTasks(OmarOS_StaticTaskTable, sizeof(OmarOS_StaticTaskTable) / sizeof(OmarOS_StaticTaskTable[0]))
+
+#endif /* INC_OMAROS_STATICTASKS_H_ */
@@ -0,0 +1,78 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_Timer.h 			                             */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+#ifndef INC_OMAROS_TIMER_H_
+#define INC_OMAROS_TIMER_H_
+
+//----------------------------------------------
+// Section: Includes
+//----------------------------------------------
+#include "scheduler.h"
+
+//----------------------------------------------
+// Section: User type definitions
+//----------------------------------------------
+typedef struct Timer_ref{
+	void (*pf_Callback)(struct Timer_ref* pTimer); /* Runs in the timer service task */
+	void* pArgument;							  /* Free for the callback's use */
+
+	struct Timer_ref* pNext;	/* Not entered by the user */
+	uint32 ExpiryTick;			/* Not entered by the user */
+	uint32 Period;				/* Not entered by the user */
+	uint8 Active;				/* Not entered by the user */
+}Timer_ref;
+
+/*
+ * =============================================
+ * APIs Supported by "OmarOS Software Timers"
+ * =============================================
+ *
+ * Enabled with OMAROS_USE_TIMERS. Active timers are kept in one list sorted by expiry tick, so
+ * SysTick only compares the list head with the tick count. When the head is due the timer service
+ * task is activated and runs every expired callback in one go, then goes back to sleep.
+ * Callbacks share the service task stack (OMAROS_TIMER_STACK_SIZE) and must not wait.
+ */
+
+/**=============================================
+ * @Fn			- OmarOS_TimerStart
+ * @brief 		- Starts (or restarts) a one-shot or auto-reload timer
+ * @param [in] 	- pTimer: Pointer to the timer, pf_Callback must be set
+ * @param [in] 	- Delay: Ticks before the first expiry
+ * @param [in] 	- Period: Ticks between later expiries, 0 for a one-shot timer
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- Can be called from tasks and from timer callbacks, not from ISRs
+ */
+OmarOS_errorTypes OmarOS_TimerStart(Timer_ref* pTimer, uint32 Delay, uint32 Period);
+
+/**=============================================
+ * @Fn			- OmarOS_TimerStop
+ * @brief 		- Stops a timer, its callback won't run until it is started again
+ * @param [in] 	- pTimer: Pointer to the timer
+ * @retval 		- None
+ * Note			- Can be called from tasks and from timer callbacks, not from ISRs
+ */
+void OmarOS_TimerStop(Timer_ref* pTimer);
+
+/**=============================================
+ * @Fn			- OmarOS_TimerInit
+ * @brief 		- Creates the timer service task
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- Called by OmarOS_Init
+ */
+OmarOS_errorTypes OmarOS_TimerInit(void);
+
+/**=============================================
+ * @Fn			- OmarOS_TimerTick
+ * @brief 		- Activates the timer service task when the earliest timer is due
+ * @param [in] 	- Now: Current tick count
+ * @retval 		- None
+ * Note			- Called by SysTick_Handler, constant time
+ */
+void OmarOS_TimerTick(uint32 Now);
+
+#endif /* INC_OMAROS_TIMER_H_ */
@@ -12,8 +12,14 @@
 //----------------------------------------------
 // Section: Includes
 //----------------------------------------------
+#include "OmarOSConfig.h"
 #include "CortexMX_OS_porting.h"
 #include "string_lib.h"
+#include "OmarOS_FIFO.h"
+#include "OmarOS_NameHash.h"
+#if (OMAROS_USE_REENT == 1)
+#include <reent.h>
+#endif
 
 //----------------------------------------------
 // Section: User type definitions
@@ -23,45 +29,130 @@ typedef enum{
 	readyQueueInitError,
 	taskExceededStackSize,
 	MutexReachedMaxNoOfUsers,
-	MutexIsAlreadyAcquired
+	MutexIsAlreadyAcquired,
+	MemPoolInvalidConfig,
+	MemPoolInvalidBlock,
+	HeapInvalidRegion,
+	MaxNoOfTasksReached,
+	TaskInvalidPriority,
+	TimerInvalidConfig,
+	TaskInvalidBudget,
+	TaskAdmissionRejected,
+	TaskDeleteQueueFull
 }OmarOS_errorTypes;
 
+/* Index into the Scheduling Table, wide enough for MAX_NO_TASKS */
+#if (MAX_NO_TASKS <= 0xFF)
+typedef uint8 OmarOS_TaskIndex;
+#elif (MAX_NO_TASKS <= 0xFFFF)
+typedef uint16 OmarOS_TaskIndex;
+#else
+typedef uint32 OmarOS_TaskIndex;
+#endif
+
+/* Task_Config.AutoStart values */
+typedef enum{
+	Autostart_Disabled,
+	Autostart_Enabled
+}Task_AutoStart;
+
+/* Task_ref.TaskState values */
+typedef enum{
+	Suspended,
+	Running,
+	Waiting,
+	Ready
+}Task_State;
+
+/* Task_ref.Block_State values */
+typedef enum{
+	enabled,
+	disabled
+}Task_BlockState;
+
+/* Cold part of a task: written by the user once and only read when the task is created,
+ * can be declared const to be kept in flash */
 typedef struct{
-	const char TaskName[30];
-	enum{
-		Autostart_Disabled,
-		Autostart_Enabled
-	}AutoStart;
-	uint8 Priority;
+#if (OMAROS_USE_NAMES == 1)
+	const char* TaskName;
+#endif
+	uint32 NameHash;			/* OMAROS_NAME_HASH of the name (set with OMAROS_TASK_NAME), used by OmarOS_FindTask */
 	void (*pf_TaskEntry)(void); /* Pointer to Task C Function*/
-
 	uint32 Stack_Size;
-	uint32 _S_PSP_Task;	 /* Not entered by the user */
-	uint32 _E_PSP_Task;	 /* Not entered by the user */
-	uint32* Current_PSP; /* Not entered by the user */
+	uint8 Priority;				/* Priority the task is created with, 0 (highest) to OMAROS_IDLE_PRIORITY */
+	uint8 AutoStart;			/* Task_AutoStart */
+	uint8 TimeSlice;			/* Round robin quantum in ticks, 0 = OMAROS_DEFAULT_TIME_SLICE */
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+	uint32 RelativeDeadline;	/* Ticks from a release to its deadline, 0 = no deadline (runs after tasks that have one, in round robin with the others) */
+#endif
+#if (OMAROS_USE_ADMISSION_CONTROL == 1)
+	uint32 Budget;				/* Ticks the task may run per Period, 0 = not admission controlled */
+	uint32 Period;				/* Ticks between two budget replenishments */
+#endif
+#if (HEAP_TASK_QUOTAS == 1)
+	uint32 HeapQuota;			/* Max heap bytes owned by the task, 0 = unlimited */
+#endif
+}Task_Config;
 
-	enum{
-		Suspended,
-		Running,
-		Waiting,
-		Ready
-	}TaskState;
+/* Task Control Block, only pConfig is entered by the user */
+typedef struct{
+	/* Hot part: touched by PendSV, SysTick and the scheduler, kept in the first 12 bytes */
+	uint32* Current_PSP;
+	uint32 WakeUpTick;			/* Tick count the task waits for while Block_State is enabled */
+	uint8 Priority;				/* Current priority, raised while holding a priority ceiling mutex */
+	uint8 TaskState;			/* Task_State */
+	uint8 Block_State;			/* Task_BlockState */
+	uint8 SliceRemaining;		/* Ticks left in the current quantum */
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+	uint32 AbsDeadline;			/* Tick count the current job must finish by */
+	uint32 BackgroundOrder;		/* Turn among the tasks without a deadline, older runs first */
+#endif
 
+	/* Cold part */
+	const Task_Config* pConfig;
+	uint32 _S_PSP_Task;
+	uint32 _E_PSP_Task;
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+	uint32 DeadlineMisses;		/* Jobs that finished after their deadline */
+#endif
+#if (OMAROS_USE_RUNTIME_STATS == 1)
 	struct{
-		enum{
-			enabled,
-			disabled
-		}Task_Block_State;
-		uint32 Ticks_Count;
-	}TimeWaiting;
+		uint64 RunTime;			/* SysTick clock cycles spent running (ISRs included) */
+		uint32 JobTime;			/* Cycles used so far by the current job */
+		uint32 MaxJobTime;		/* Longest job seen, the measured WCET */
+		uint32 Jobs;			/* Jobs finished (the task waited or terminated itself) */
+		uint8 JobEnded;			/* Not entered by the user */
+	}Stats;
+#endif
+#if (OMAROS_USE_ADMISSION_CONTROL == 1)
+	struct{
+		uint32 Utilization;		/* Budget/Period in parts per million */
+		uint32 Used;			/* Ticks used in the current period */
+		uint32 ReplenishTick;	/* Tick count the current period ends */
+		uint32 Overruns;		/* Periods the task used its whole budget in */
+		uint8 Admitted;			/* Not entered by the user */
+		uint8 Demoted;			/* Not entered by the user */
+	}Admission;
+#endif
+#if (HEAP_TASK_QUOTAS == 1)
+	uint32 HeapUsed;			/* Heap bytes owned by the task */
+#endif
+#if (OMAROS_USE_REENT == 1)
+	struct _reent Reent;		/* C library state, _impure_ptr while the task runs */
+#endif
 }Task_ref;
 
-typedef struct{
+#if (OMAROS_USE_MUTEX == 1)
+typedef struct Mutex_ref{
 	uint8 *pPayload;
 	uint32 PayloadSize;
 	Task_ref* CurrentTUser;
 	Task_ref* NextTUser;
-	char MutexName[30];
+#if (OMAROS_USE_NAMES == 1)
+	const char* MutexName;
+#endif
+	uint32 NameHash;			/* OMAROS_NAME_HASH of the name (set with OMAROS_MUTEX_NAME), used by OmarOS_FindMutex */
+	struct Mutex_ref* pNextMutex; /* Not entered by the user, list of mutexes added by OmarOS_RegisterMutex */
 	struct{
 		enum{
 			PriorityCeiling_enabled,
@@ -71,12 +162,34 @@ typedef struct{
 		uint8 old_priority;
 	}PriorityCeiling;
 }Mutex_ref;
+#endif
 
-//----------------------------------------------
-// Section: Macros Configuration References
-//----------------------------------------------
-#define MAX_NO_TASKS	100
+/* Scheduler counters, see OmarOS_GetSchedulerStats */
+typedef struct{
+	uint32 ContextSwitches;	/* Decisions that switched to another task */
+	uint32 AvoidedSwitches;	/* Decisions that kept the running task, no PendSV was pended */
+}Scheduler_stats;
+
+/* Periodic release helper, see OmarOS_PeriodicInit/OmarOS_PeriodicWait */
+typedef struct{
+	uint32 Period;			/* Ticks between two releases */
+	uint32 NextRelease;		/* Not entered by the user */
 
+	/* Statistics */
+	uint32 Releases;		/* Jobs started */
+	uint32 Overruns;		/* Releases skipped because the previous job was still running at its next release */
+	uint32 LastJitter;		/* Ticks between the last release time and the task running again */
+	uint32 MaxJitter;
+}Periodic_ref;
+
+/* Wrap safe check of a tick count against a deadline (both from OmarOS_GetTickCount) */
+#define OMAROS_TICK_REACHED(Now, Tick)	((sint32)((uint32)(Now) - (uint32)(Tick)) >= 0)
+
+/* Converts a difference of OmarOS_GetTimestamp values to microseconds */
+#define OMAROS_TIMESTAMP_TO_US(Timestamp)	((Timestamp) / (OS_CPU_CLOCK_HZ / 1000000UL))
+
+/* Ready Queue FIFO of task pointers */
+FIFO_DECLARE(FIFO, Task_ref*);
 
 /*
  * =============================================
@@ -95,20 +208,33 @@ OmarOS_errorTypes OmarOS_Init(void);
 /**=============================================
  * @Fn			- OmarOS_CreateTask
  * @brief 		- Creates the task object in the OS and initializes the task's stack area
- * @param [in] 	- newTask: Pointer to the task's configuration
+ * @param [in] 	- newTask: Pointer to the task's control block, newTask->pConfig must point to its configuration
  * @retval 		- Returns noError if no error happened or an error code if an error occured
- * Note			- Should only be called after calling "OmarOS_Init"
+ * Note			- Should only be called after calling "OmarOS_Init", stacks released by OmarOS_DeleteTask are reused (best fit)
  */
 OmarOS_errorTypes OmarOS_CreateTask(Task_ref* newTask);
 
+/**=============================================
+ * @Fn			- OmarOS_RegisterStaticTasks
+ * @brief 		- Adds tasks whose stacks were laid out at build time to the Scheduling Table
+ * @param [in] 	- pTasks: Table of tasks generated by OMAROS_STATIC_TASKS_DEFINE
+ * @param [in] 	- NoOfTasks: Number of entries in the table
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- Should only be called after calling "OmarOS_Init" and before "OmarOS_StartOS",
+ * 				  use OMAROS_REGISTER_STATIC_TASKS() from "OmarOS_StaticTasks.h"
+ */
+OmarOS_errorTypes OmarOS_RegisterStaticTasks(Task_ref* const pTasks[], uint32 NoOfTasks);
+
 /**=============================================
  * @Fn			- OmarOS_ActivateTask
  * @brief 		- Sends a task to the ready queue to be scheduled
  * @param [in] 	- pTask: Pointer to the task's configuration
- * @retval 		- None
+ * @retval 		- Returns noError, or TaskAdmissionRejected if admission control is enabled and the task's
+ * 				  utilization doesn't fit under the bound (the task stays suspended)
  * Note			- Should only be called after calling "OmarOS_CreateTask"
+ * 				  With OMAROS_USE_ADMISSION_CONTROL a task keeps its utilization until it terminates itself
  */
-void OmarOS_ActivateTask(Task_ref* pTask);
+OmarOS_errorTypes OmarOS_ActivateTask(Task_ref* pTask);
 
 /**=============================================
  * @Fn			- OmarOS_TerminateTask
@@ -116,9 +242,23 @@ void OmarOS_ActivateTask(Task_ref* pTask);
  * @param [in] 	- pTask: Pointer to the task's configuration
  * @retval 		- None
  * Note			- Should only be called after calling "OmarOS_CreateTask"
+ * 				  A task terminating itself with the scheduler suspended is switched out by OmarOS_ResumeScheduler
  */
 void OmarOS_TerminateTask(Task_ref* pTask);
 
+/**=============================================
+ * @Fn			- OmarOS_DeleteTask
+ * @brief 		- Removes a task from the OS and releases its stack so a later OmarOS_CreateTask can reuse it
+ * @param [in] 	- pTask: Pointer to the task's configuration
+ * @retval 		- Returns noError, or TaskDeleteQueueFull if the task was not deleted
+ * Note			- A task can delete itself, its stack is then released once it is switched out. Up to
+ * 				  DELETED_QUEUE_SIZE such stacks wait for the idle task, past that the task keeps running
+ * 				  With OMAROS_USE_REENT the C library state of the task is reclaimed by the caller, for a
+ * 				  task that deleted itself by the next OmarOS_CreateTask or OmarOS_DeleteTask
+ * 				  Mutexes held by the task are not released
+ */
+OmarOS_errorTypes OmarOS_DeleteTask(Task_ref* pTask);
+
 /**=============================================
  * @Fn			- OmarOS_StartOS
  * @brief 		- Starts the OS scheduler to begin running tasks
@@ -137,6 +277,64 @@ void OmarOS_StartOS(void);
  */
 void OmarOS_TaskWait(uint32 Ticks, Task_ref* pTask);
 
+/**=============================================
+ * @Fn			- OmarOS_TaskWaitUntil
+ * @brief 		- Sends a task to the waiting state until the tick count reaches an absolute value
+ * @param [in] 	- WakeUpTick: Tick count at which the task runs again (wraps around like OmarOS_GetTickCount)
+ * @param [in] 	- pTask: Pointer to the task's configuration
+ * @retval 		- None
+ * Note			- Returns right away if WakeUpTick is already reached, unlike OmarOS_TaskWait the
+ * 				  time the task spent running before the call doesn't delay the wake up
+ */
+void OmarOS_TaskWaitUntil(uint32 WakeUpTick, Task_ref* pTask);
+
+/**=============================================
+ * @Fn			- OmarOS_GetTickCount
+ * @brief 		- Returns the number of SysTick interrupts since OmarOS_StartOS
+ * @retval 		- Current tick count, wraps around after 2^32 ticks
+ * Note			- Compare tick values by their difference ((sint32)(a - b) >= 0) to stay wrap safe
+ */
+uint32 OmarOS_GetTickCount(void);
+
+/**=============================================
+ * @Fn			- OmarOS_GetTickCount64
+ * @brief 		- Returns the number of SysTick interrupts since OmarOS_StartOS as a 64 bits value
+ * @retval 		- Current tick count, never wraps around
+ * Note			- Lock free and without a system call, safe from tasks and ISRs
+ */
+uint64 OmarOS_GetTickCount64(void);
+
+/**=============================================
+ * @Fn			- OmarOS_GetTimestamp
+ * @brief 		- Returns a high resolution timestamp: SysTick clock cycles since OmarOS_StartOS
+ * @retval 		- Current timestamp, convert it with OMAROS_TIMESTAMP_TO_US
+ * Note			- Privileged callers and ISRs read SysTick directly, tasks go through a system call
+ * 				  because the SysTick registers can't be accessed unprivileged
+ */
+uint64 OmarOS_GetTimestamp(void);
+
+/**=============================================
+ * @Fn			- OmarOS_PeriodicInit
+ * @brief 		- Prepares a periodic release with its first release at the current tick
+ * @param [out] - pPeriodic: Pointer to the periodic object
+ * @param [in] 	- Period: Ticks between two releases
+ * @retval 		- None
+ * Note			- Called once by the task before its loop
+ */
+void OmarOS_PeriodicInit(Periodic_ref* pPeriodic, uint32 Period);
+
+/**=============================================
+ * @Fn			- OmarOS_PeriodicWait
+ * @brief 		- Waits for the next release of a periodic task
+ * @param [in] 	- pPeriodic: Pointer to the periodic object
+ * @param [in] 	- pTask: Pointer to the task's configuration
+ * @retval 		- None
+ * Note			- Releases are kept on the exact period grid whatever the job execution time,
+ * 				  releases already missed are skipped and counted in pPeriodic->Overruns
+ */
+void OmarOS_PeriodicWait(Periodic_ref* pPeriodic, Task_ref* pTask);
+
+#if (OMAROS_USE_MUTEX == 1)
 /**=============================================
  * @Fn			- OmarOS_AcquireMutex
  * @brief 		- Tries to acquire a mutex if available
@@ -156,4 +354,89 @@ OmarOS_errorTypes OmarOS_AcquireMutex(Mutex_ref* pMutex, Task_ref* pTask);
  */
 void OmarOS_ReleaseMutex(Mutex_ref* pMutex);
 
+/**=============================================
+ * @Fn			- OmarOS_RegisterMutex
+ * @brief 		- Adds a mutex to the list searched by OmarOS_FindMutex
+ * @param [in] 	- pMutex: Pointer to the Mutex, its NameHash must be set (OMAROS_MUTEX_NAME)
+ * @retval 		- None
+ * Note			- Only needed for mutexes that are looked up by name, a mutex must be registered once
+ */
+void OmarOS_RegisterMutex(Mutex_ref* pMutex);
+
+/**=============================================
+ * @Fn			- OmarOS_FindMutex
+ * @brief 		- Returns the registered mutex whose name hashes to NameHash
+ * @param [in] 	- NameHash: OMAROS_NAME_HASH("name") or OmarOS_NameHash(name)
+ * @retval 		- Pointer to the Mutex, NULL if none was found
+ * Note			- Walks the registered mutexes comparing one word each, no string is compared
+ */
+Mutex_ref* OmarOS_FindMutex(uint32 NameHash);
+#endif
+
+/**=============================================
+ * @Fn			- OmarOS_NameHash
+ * @brief 		- Hashes a name at run time the way OMAROS_NAME_HASH does at build time
+ * @param [in] 	- pName: Pointer to the null terminated name
+ * @retval 		- 32 bits FNV-1a hash of the first OMAROS_NAME_HASH_MAX_LENGTH characters
+ * Note			- For names that are only known at run time (received from a shell or a host tool)
+ */
+uint32 OmarOS_NameHash(const char* pName);
+
+/**=============================================
+ * @Fn			- OmarOS_FindTask
+ * @brief 		- Returns the task in the Scheduling Table whose name hashes to NameHash
+ * @param [in] 	- NameHash: OMAROS_NAME_HASH("name") or OmarOS_NameHash(name)
+ * @retval 		- Pointer to the task, NULL if none was found
+ * Note			- Tasks created with NameHash 0 are hashed from their TaskName (OMAROS_USE_NAMES == 1)
+ */
+Task_ref* OmarOS_FindTask(uint32 NameHash);
+
+/**=============================================
+ * @Fn			- OmarOS_SuspendScheduler
+ * @brief 		- Prevents context switches until OmarOS_ResumeScheduler is called
+ * @retval 		- None
+ * Note			- Calls can be nested, interrupts are still serviced while the scheduler is suspended
+ * 				  A task must not wait or block on a mutex while the scheduler is suspended. It may terminate
+ * 				  itself only under a single level of suspension, followed by OmarOS_ResumeScheduler: the
+ * 				  switch is pended and done by the resume, the task runs until then
+ */
+void OmarOS_SuspendScheduler(void);
+
+/**=============================================
+ * @Fn			- OmarOS_ResumeScheduler
+ * @brief 		- Allows context switches again and performs any switch requested while suspended
+ * @retval 		- None
+ * Note			- Must be called once for every call to OmarOS_SuspendScheduler
+ */
+void OmarOS_ResumeScheduler(void);
+
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+/**=============================================
+ * @Fn			- OmarOS_GetDeadlineMisses
+ * @brief 		- Returns the number of jobs of all tasks that finished after their deadline
+ * @retval 		- Deadline misses since OmarOS_StartOS
+ * Note			- A job finishes when its task waits or terminates, per task counts are in Task_ref.DeadlineMisses
+ */
+uint32 OmarOS_GetDeadlineMisses(void);
+#endif
+
+#if (OMAROS_USE_STATS == 1)
+/**=============================================
+ * @Fn			- OmarOS_GetSchedulerStats
+ * @brief 		- Reports how many context switches were done and how many were skipped
+ * @param [out] - pStats: Pointer to the structure to be filled
+ * @retval 		- None
+ * Note			- None
+ */
+void OmarOS_GetSchedulerStats(Scheduler_stats* pStats);
+#endif
+
+/**=============================================
+ * @Fn			- OmarOS_GetCurrentTask
+ * @brief 		- Returns the task that is currently running
+ * @retval 		- Pointer to the running task's configuration, NULL if the OS is not started yet
+ * Note			- None
+ */
+Task_ref* OmarOS_GetCurrentTask(void);
+
 #endif /* INC_SCHEDULER_H_ */
@@ -9,10 +9,15 @@
 #ifndef STRING_LIB_H_
 #define STRING_LIB_H_
 
+#include <stddef.h>
+
 #ifndef NULL
 #define NULL	0
 #endif
 
+/* Lower case of every character value (only ASCII letters change), the case folding of the library */
+extern const unsigned char STRING_lower_table[256];
+
 /*
  * =============================================
  * APIs Supported by "Driver Name"
@@ -114,7 +119,7 @@ signed char STRING_compare_caseSensitive(const unsigned char* str1, const unsign
   * @param [in] 	- str2: Pointer to the second string
   * @param [out] 	- None
   * @retval 		- Returns 0 if str1 is same as str2. Returns -1 if str1 < str2. Returns 1 if str1 > str2
-  * Note			- None
+  * Note			- Letters are compared in lower case
   */
 signed char STRING_compare_caseInsensitive(const unsigned char* str1, const unsigned char* str2);
 
@@ -138,7 +143,7 @@ signed char STRING_compare_caseSensitive_length(const unsigned char* str1, const
   * @param [in] 	- length: Length of characters to check
   * @param [out] 	- None
   * @retval 		- Returns 0 if str1 is same as str2 for length "length". Returns -1 if str1 < str2. Returns 1 if str1 > str2
-  * Note			- None
+  * Note			- Letters are compared in lower case
   */
 signed char STRING_compare_caseInsensitive_length(const unsigned char* str1, const unsigned char* str2, const unsigned short length);
 
@@ -182,7 +187,10 @@ unsigned short STRING_length(const unsigned char* str);
   * @param [in] 	- word: Pointer to the string to find the first occurrence of it
   * @param [out] 	- None
   * @retval 		- Pointer to the location of the first occurrence of "word" in "str"
-  * Note			- None
+  * Note			- Returns NULL if "word" was not found, an empty "word" is found at the start of "str"
+  * 				  Strings of any length, words of 4 characters or more are searched with Boyer-Moore-Horspool
+  * 				  The whole of "str" is read to measure it first, the search then skips comparisons
+  * 				  Its skip table takes STRING_SEARCH_SKIP_SIZE bytes (64) of the calling task's stack
   */
 unsigned char* STRING_word_firstOccurrence(const unsigned char* str, const unsigned char* word);
 
@@ -193,8 +201,72 @@ unsigned char* STRING_word_firstOccurrence(const unsigned char* str, const unsig
   * @param [in] 	- word: Pointer to the string to find the last occurrence of it
   * @param [out] 	- None
   * @retval 		- Pointer to the location of the last occurrence of "word" in "str"
-  * Note			- None
+  * Note			- Returns NULL if "word" was not found, an empty "word" is found at the end of "str"
+  * 				  Searches backward from the end of "str" and stops at the first match
   */
 unsigned char* STRING_word_lastOccurrence(const unsigned char* str, const unsigned char* word);
 
+/**=============================================
+  * @Fn				- STRING_word_firstOccurrence_caseInsensitive
+  * @brief 			- Returns pointer to first occurrence of "word" in "str" ignoring the letters case
+  * @param [in] 	- str : Pointer to the array containing the string to search for
+  * @param [in] 	- word: Pointer to the string to find the first occurrence of it
+  * @param [out] 	- None
+  * @retval 		- Pointer to the location of the first occurrence of "word" in "str"
+  * Note			- Returns NULL if "word" was not found, an empty "word" is found at the start of "str"
+  * 				  Same Boyer-Moore-Horspool search as STRING_word_firstOccurrence with a case folded skip table
+  */
+unsigned char* STRING_word_firstOccurrence_caseInsensitive(const unsigned char* str, const unsigned char* word);
+
+/**=============================================
+  * @Fn				- STRING_memory_copy
+  * @brief 			- Copies "size" bytes from "src" into "des"
+  * @param [in] 	- src : Pointer to the source memory
+  * @param [in] 	- des : Pointer to the destination memory
+  * @param [in] 	- size: Number of bytes to be copied
+  * @param [out] 	- None
+  * @retval 		- Pointer to "des"
+  * Note			- The two areas must not overlap, use STRING_memory_move if they can
+  * 				  Word aligned bulk is copied 16 bytes at a time with LDM/STM on ARM targets
+  */
+void* STRING_memory_copy(const void* src, void* des, size_t size);
+
+/**=============================================
+  * @Fn				- STRING_memory_move
+  * @brief 			- Copies "size" bytes from "src" into "des", the two areas may overlap
+  * @param [in] 	- src : Pointer to the source memory
+  * @param [in] 	- des : Pointer to the destination memory
+  * @param [in] 	- size: Number of bytes to be copied
+  * @param [out] 	- None
+  * @retval 		- Pointer to "des"
+  * Note			- Copies backward when "des" is inside the source area
+  */
+void* STRING_memory_move(const void* src, void* des, size_t size);
+
+/**=============================================
+  * @Fn				- STRING_memory_compare
+  * @brief 			- Compares the first "size" bytes of two memory areas
+  * @param [in] 	- ptr1: Pointer to the first memory area
+  * @param [in] 	- ptr2: Pointer to the second memory area
+  * @param [in] 	- size: Number of bytes to be compared
+  * @param [out] 	- None
+  * @retval 		- Returns 0 if the areas are identical. Returns -1 if ptr1 < ptr2. Returns 1 if ptr1 > ptr2
+  * Note			- Bytes are compared as unsigned values, null bytes don't stop the comparison
+  */
+signed char STRING_memory_compare(const void* ptr1, const void* ptr2, size_t size);
+
+/**=============================================
+  * @Fn				- STRING_memory_search
+  * @brief 			- Returns pointer to first occurrence of the "word_length" bytes of "word" in the "str_length" bytes of "str"
+  * @param [in] 	- str		 : Pointer to the memory to search in
+  * @param [in] 	- str_length : Number of bytes in "str"
+  * @param [in] 	- word		 : Pointer to the bytes to find
+  * @param [in] 	- word_length: Number of bytes in "word"
+  * @param [out] 	- None
+  * @retval 		- Pointer to the first occurrence of "word" in "str"
+  * Note			- Returns NULL if "word" was not found, null bytes are compared like any other byte
+  * 				  Same search as STRING_word_firstOccurrence without measuring the strings first
+  */
+void* STRING_memory_search(const void* str, size_t str_length, const void* word, size_t word_length);
+
 #endif /* STRING_LIB_H_ */
@@ -0,0 +1,172 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : String_Library                                    	 */
+/* File          : string_tokenizer.h                              	     */
+/* Date          : Jun 22, 2023                                          */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+#ifndef STRING_TOKENIZER_H_
+#define STRING_TOKENIZER_H_
+
+//----------------------------------------------
+// Section: Includes
+//----------------------------------------------
+#include "string_view.h"
+
+//----------------------------------------------
+// Section: User type definitions
+//----------------------------------------------
+
+/* One bit per character value, a character is tested with a single load whatever the number of delimiters */
+typedef struct{
+	unsigned char Bits[256 / 8];
+}STRING_delimiters;
+
+/* A field found by a tokenizer, the characters stay where they are in the buffer */
+typedef struct{
+	size_t Offset;			/* From the start of the buffer (record in push mode), after the opening quote */
+	size_t Length;			/* Without the quotes */
+	unsigned short Index;	/* 0 for the first field of a buffer (record) */
+	unsigned char Flags;	/* STRING_FIELD_xxx */
+}STRING_field;
+
+/* Tokenizer over a complete buffer, fields are taken one by one with STRING_tokenizer_next */
+typedef struct{
+	const unsigned char* pData;
+	size_t Length;
+	size_t Position;						/* Start of the next field */
+	const STRING_delimiters* pDelimiters;
+	unsigned short Index;
+	unsigned char Quote;					/* Character that opens a quoted field, 0: no quoted fields */
+	unsigned char Done;						/* The last field was given */
+}STRING_tokenizer;
+
+/* Called by STRING_stream_push for every field, "pRecord" holds the record received so far
+ * (previous fields of the same record included) and is valid until the callback returns.
+ * A record that doesn't fit ends with an empty field flagged STRING_FIELD_ABORTED */
+typedef void (*STRING_field_callback)(void* pContext, const unsigned char* pRecord, const STRING_field* pField);
+
+/* Tokenizer fed with chunks of any size (a UART ring buffer), the bytes of the current record are kept in "pRecord" */
+typedef struct{
+	unsigned char* pRecord;
+	size_t Capacity;
+	size_t Length;
+	size_t FieldStart;
+	size_t FieldEnd;
+	const STRING_delimiters* pDelimiters;
+	const STRING_delimiters* pTerminators;	/* End a record, not stored in "pRecord" */
+	STRING_field_callback pfCallback;
+	void* pContext;
+	unsigned long Overflows;				/* Records dropped because they didn't fit in "pRecord" */
+	unsigned short Index;
+	unsigned char Quote;
+	unsigned char State;
+	unsigned char Flags;
+}STRING_stream_tokenizer;
+
+//----------------------------------------------
+// Section: Macros Configuration References
+//----------------------------------------------
+
+/* STRING_field.Flags */
+#define STRING_FIELD_QUOTED		0x01	/* Was quoted, doubled quotes inside it are left as they are */
+#define STRING_FIELD_LAST		0x02	/* Last field of the buffer (record) */
+#define STRING_FIELD_ABORTED	0x04	/* With STRING_FIELD_LAST, the record was too long and its fields given so far are to be dropped */
+
+/* Not 0 if "c" is in the set */
+#define STRING_DELIMITERS_HAS(pSet, c)	((pSet)->Bits[(unsigned char)(c) >> 3] & (1U << ((unsigned char)(c) & 7)))
+
+/*
+ * =============================================
+ * APIs Supported by "String Tokenizer"
+ * =============================================
+ */
+
+/**=============================================
+  * @Fn				- STRING_delimiters_init
+  * @brief 			- Fills a delimiters set with the characters of a string
+  * @param [out] 	- pSet		 : Pointer to the set
+  * @param [in] 	- delimiters : Null terminated string of the delimiter characters (",*" for NMEA)
+  * @retval 		- None
+  * Note			- Built once, usually at startup, and shared by any number of tokenizers
+  */
+void STRING_delimiters_init(STRING_delimiters* pSet, const unsigned char* delimiters);
+
+/**=============================================
+  * @Fn				- STRING_tokenizer_init
+  * @brief 			- Prepares a tokenizer over the "length" characters of "data"
+  * @param [out] 	- pTokenizer : Pointer to the tokenizer
+  * @param [in] 	- data		 : Pointer to one record, without its line ending
+  * @param [in] 	- length	 : Number of characters in "data"
+  * @param [in] 	- pDelimiters: Pointer to the delimiters set
+  * @param [in] 	- quote		 : Character that opens a quoted field ('"' for CSV), 0 if fields are never quoted
+  * @retval 		- None
+  * Note			- An empty buffer has no fields, otherwise N delimiters give N + 1 fields
+  */
+void STRING_tokenizer_init(STRING_tokenizer* pTokenizer, const void* data, size_t length, const STRING_delimiters* pDelimiters, unsigned char quote);
+
+/**=============================================
+  * @Fn				- STRING_tokenizer_next
+  * @brief 			- Gives the next field of the buffer
+  * @param [in] 	- pTokenizer : Pointer to the tokenizer
+  * @param [out] 	- pField	 : Pointer to the field to be filled
+  * @retval 		- Returns 1 if a field was given, 0 after the last field
+  * Note			- Every character is read once, delimiters inside a quoted field are part of the field
+  */
+unsigned char STRING_tokenizer_next(STRING_tokenizer* pTokenizer, STRING_field* pField);
+
+/**=============================================
+  * @Fn				- STRING_field_view
+  * @brief 			- Returns a view of a field
+  * @param [in] 	- base	: Pointer to the buffer (record) the field was found in
+  * @param [in] 	- pField: Pointer to the field
+  * @param [out] 	- None
+  * @retval 		- The view
+  * Note			- None
+  */
+STRING_view STRING_field_view(const void* base, const STRING_field* pField);
+
+/**=============================================
+  * @Fn				- STRING_stream_init
+  * @brief 			- Prepares a tokenizer that is fed with STRING_stream_push
+  * @param [out] 	- pStream	  : Pointer to the tokenizer
+  * @param [in] 	- storage	  : Pointer to the memory holding the current record
+  * @param [in] 	- capacity	  : Bytes in "storage", longer records are dropped (see STRING_stream_push)
+  * @param [in] 	- pDelimiters : Pointer to the delimiters set
+  * @param [in] 	- pTerminators: Pointer to the set of characters ending a record ("\r\n")
+  * @param [in] 	- quote		  : Character that opens a quoted field, 0 if fields are never quoted
+  * @param [in] 	- pfCallback  : Function called for every field
+  * @param [in] 	- pContext	  : Passed to "pfCallback" as it is
+  * @retval 		- None
+  * Note			- Empty records ("\r\n" line endings) are skipped
+  */
+void STRING_stream_init(STRING_stream_tokenizer* pStream, unsigned char* storage, size_t capacity, const STRING_delimiters* pDelimiters,
+		const STRING_delimiters* pTerminators, unsigned char quote, STRING_field_callback pfCallback, void* pContext);
+
+/**=============================================
+  * @Fn				- STRING_stream_push
+  * @brief 			- Tokenizes the next "length" received characters
+  * @param [in] 	- pStream: Pointer to the tokenizer
+  * @param [in] 	- data	 : Pointer to the received characters
+  * @param [in] 	- length : Number of characters in "data"
+  * @param [out] 	- None
+  * @retval 		- None
+  * Note			- A field is given as soon as its delimiter arrives, records and quoted fields can be split over any
+  * 				  number of pushes. A ring buffer is pushed as its two contiguous parts
+  * 				  When a record outgrows the storage its fields given so far are followed by an empty field flagged
+  * 				  STRING_FIELD_ABORTED | STRING_FIELD_LAST, the rest of the record is dropped and counted in Overflows
+  */
+void STRING_stream_push(STRING_stream_tokenizer* pStream, const void* data, size_t length);
+
+/**=============================================
+  * @Fn				- STRING_stream_reset
+  * @brief 			- Drops the record received so far
+  * @param [in] 	- pStream: Pointer to the tokenizer
+  * @param [out] 	- None
+  * @retval 		- None
+  * Note			- Used after a receive error, the next pushed character starts a new record
+  */
+void STRING_stream_reset(STRING_stream_tokenizer* pStream);
+
+#endif /* STRING_TOKENIZER_H_ */
@@ -0,0 +1,207 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : String_Library                                    	 */
+/* File          : string_view.h                              	         */
+/* Date          : Jun 22, 2023                                          */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+#ifndef STRING_VIEW_H_
+#define STRING_VIEW_H_
+
+//----------------------------------------------
+// Section: Includes
+//----------------------------------------------
+#include "string_lib.h"
+
+//----------------------------------------------
+// Section: User type definitions
+//----------------------------------------------
+
+/* Read only characters given by their length, not null terminated (a part of a frame, a token) */
+typedef struct{
+	const unsigned char* pData;
+	size_t Length;
+}STRING_view;
+
+/* Bounded output buffer, always null terminated, its end is known so appends never rescan it */
+typedef struct{
+	unsigned char* pData;
+	size_t Length;		/* Characters written, the terminating null excluded */
+	size_t Capacity;	/* Bytes in pData, one is kept for the terminating null */
+	unsigned char Truncated; /* Set when an append didn't fit */
+}STRING_buffer;
+
+/* Returned by STRING_view_find when nothing was found */
+#define STRING_VIEW_NPOS	((size_t)-1)
+
+/*
+ * =============================================
+ * APIs Supported by "String Views"
+ * =============================================
+ */
+
+/**=============================================
+  * @Fn				- STRING_view_make
+  * @brief 			- Makes a view of "length" characters starting at "data"
+  * @param [in] 	- data  : Pointer to the first character
+  * @param [in] 	- length: Number of characters
+  * @param [out] 	- None
+  * @retval 		- The view
+  * Note			- None
+  */
+STRING_view STRING_view_make(const void* data, size_t length);
+
+/**=============================================
+  * @Fn				- STRING_view_fromString
+  * @brief 			- Makes a view of a null terminated string
+  * @param [in] 	- str: Pointer to the string
+  * @param [out] 	- None
+  * @retval 		- The view, empty if "str" is NULL
+  * Note			- The only view operation that scans for the terminating null
+  */
+STRING_view STRING_view_fromString(const unsigned char* str);
+
+/**=============================================
+  * @Fn				- STRING_view_sub
+  * @brief 			- Makes a view of part of another view
+  * @param [in] 	- view  : The whole view
+  * @param [in] 	- start : Index of the first character
+  * @param [in] 	- length: Number of characters, cut at the end of "view"
+  * @param [out] 	- None
+  * @retval 		- The view, empty if "start" is past the end of "view"
+  * Note			- None
+  */
+STRING_view STRING_view_sub(STRING_view view, size_t start, size_t length);
+
+/**=============================================
+  * @Fn				- STRING_view_compare
+  * @brief 			- Compares two views (case sensitive)
+  * @param [in] 	- view1: The first view
+  * @param [in] 	- view2: The second view
+  * @param [out] 	- None
+  * @retval 		- Returns 0 if view1 is same as view2. Returns -1 if view1 < view2. Returns 1 if view1 > view2
+  * Note			- A view that is the start of the other one is the smaller
+  */
+signed char STRING_view_compare(STRING_view view1, STRING_view view2);
+
+/**=============================================
+  * @Fn				- STRING_view_equal_caseInsensitive
+  * @brief 			- Checks if two views hold the same characters ignoring the letters case
+  * @param [in] 	- view1: The first view
+  * @param [in] 	- view2: The second view
+  * @param [out] 	- None
+  * @retval 		- Returns 1 if the views are equal, 0 otherwise
+  * Note			- None
+  */
+unsigned char STRING_view_equal_caseInsensitive(STRING_view view1, STRING_view view2);
+
+/**=============================================
+  * @Fn				- STRING_view_startsWith
+  * @brief 			- Checks if "view" starts with "prefix"
+  * @param [in] 	- view  : The view to check
+  * @param [in] 	- prefix: The expected start
+  * @param [out] 	- None
+  * @retval 		- Returns 1 if "view" starts with "prefix", 0 otherwise
+  * Note			- None
+  */
+unsigned char STRING_view_startsWith(STRING_view view, STRING_view prefix);
+
+/**=============================================
+  * @Fn				- STRING_view_find
+  * @brief 			- Returns the index of the first occurrence of "word" in "view"
+  * @param [in] 	- view: The view to search in
+  * @param [in] 	- word: The characters to find
+  * @param [out] 	- None
+  * @retval 		- Index of the first occurrence, STRING_VIEW_NPOS if "word" was not found
+  * Note			- Boyer-Moore-Horspool search (STRING_memory_search), the view is not scanned for its length
+  */
+size_t STRING_view_find(STRING_view view, STRING_view word);
+
+/**=============================================
+  * @Fn				- STRING_view_split
+  * @brief 			- Takes the next token, up to "delimiter", from the start of a view
+  * @param [in] 	- pRest	   : Pointer to the view to split, moved past the token and its delimiter
+  * @param [in] 	- delimiter: Character that ends a token
+  * @param [out] 	- pToken   : Pointer to the view to receive the token, without the delimiter
+  * @retval 		- Returns 1 if a token was taken, 0 if "pRest" was already empty
+  * Note			- Two delimiters in a row give an empty token, each call only reads the token it returns
+  */
+unsigned char STRING_view_split(STRING_view* pRest, unsigned char delimiter, STRING_view* pToken);
+
+/**=============================================
+  * @Fn				- STRING_buffer_init
+  * @brief 			- Prepares an empty buffer over "storage"
+  * @param [out] 	- pBuffer : Pointer to the buffer
+  * @param [in] 	- storage : Pointer to the memory used by the buffer
+  * @param [in] 	- capacity: Bytes in "storage", the terminating null included (at least 1)
+  * @retval 		- None
+  * Note			- None
+  */
+void STRING_buffer_init(STRING_buffer* pBuffer, unsigned char* storage, size_t capacity);
+
+/**=============================================
+  * @Fn				- STRING_buffer_clear
+  * @brief 			- Empties a buffer so it can be reused
+  * @param [in] 	- pBuffer: Pointer to the buffer
+  * @param [out] 	- None
+  * @retval 		- None
+  * Note			- None
+  */
+void STRING_buffer_clear(STRING_buffer* pBuffer);
+
+/**=============================================
+  * @Fn				- STRING_buffer_append
+  * @brief 			- Appends the characters of a view at the end of a buffer
+  * @param [in] 	- pBuffer: Pointer to the buffer
+  * @param [in] 	- view	 : Characters to be appended
+  * @param [out] 	- None
+  * @retval 		- Returns 1 if everything was appended, 0 if the buffer was full (the start that fits is appended)
+  * Note			- Constant time to find the end, the buffer stays null terminated
+  */
+unsigned char STRING_buffer_append(STRING_buffer* pBuffer, STRING_view view);
+
+/**=============================================
+  * @Fn				- STRING_buffer_append_string
+  * @brief 			- Appends a null terminated string at the end of a buffer
+  * @param [in] 	- pBuffer: Pointer to the buffer
+  * @param [in] 	- str	 : Pointer to the string to be appended
+  * @param [out] 	- None
+  * @retval 		- Returns 1 if everything was appended, 0 if the buffer was full
+  * Note			- Only "str" is scanned, not the buffer
+  */
+unsigned char STRING_buffer_append_string(STRING_buffer* pBuffer, const unsigned char* str);
+
+/**=============================================
+  * @Fn				- STRING_buffer_append_char
+  * @brief 			- Appends one character at the end of a buffer
+  * @param [in] 	- pBuffer  : Pointer to the buffer
+  * @param [in] 	- character: Character to be appended
+  * @param [out] 	- None
+  * @retval 		- Returns 1 if the character was appended, 0 if the buffer was full
+  * Note			- None
+  */
+unsigned char STRING_buffer_append_char(STRING_buffer* pBuffer, unsigned char character);
+
+/**=============================================
+  * @Fn				- STRING_buffer_append_unsigned
+  * @brief 			- Appends the decimal digits of "value" at the end of a buffer
+  * @param [in] 	- pBuffer: Pointer to the buffer
+  * @param [in] 	- value	 : Number to be appended
+  * @param [out] 	- None
+  * @retval 		- Returns 1 if every digit was appended, 0 if the buffer was full
+  * Note			- None
+  */
+unsigned char STRING_buffer_append_unsigned(STRING_buffer* pBuffer, unsigned long value);
+
+/**=============================================
+  * @Fn				- STRING_buffer_view
+  * @brief 			- Returns a view of the characters in a buffer
+  * @param [in] 	- pBuffer: Pointer to the buffer
+  * @param [out] 	- None
+  * @retval 		- The view, valid until the buffer is changed
+  * Note			- None
+  */
+STRING_view STRING_buffer_view(const STRING_buffer* pBuffer);
+
+#endif /* STRING_VIEW_H_ */
@@ -0,0 +1,213 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_Console.c 			                         */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+#include "OmarOS_Console.h"
+
+#if (OMAROS_USE_CONSOLE == 1)
+
+/* Bytes the console task takes out of the buffer at once, sent outside the scheduler lock */
+#define OMAROS_CONSOLE_CHUNK_SIZE	32
+#define OMAROS_CONSOLE_MASK			(OMAROS_CONSOLE_BUFFER_SIZE - 1)
+
+extern int __io_putchar(int ch) __attribute__((weak));
+
+static void OmarOS_ConsoleService(void);
+static void OmarOS_ConsoleCopy(uint8* pDestination, uint32 Position, uint32 Length);
+
+static const Task_Config CONSOLE_TASK_CONFIG = {
+	OMAROS_TASK_NAME("consoletask"),
+	.pf_TaskEntry = OmarOS_ConsoleService,
+	.Stack_Size = OMAROS_CONSOLE_STACK_SIZE,
+	.Priority = OMAROS_CONSOLE_TASK_PRIORITY,
+	.AutoStart = Autostart_Disabled
+};
+
+/* Write and Read are free running, both are only changed with the scheduler suspended */
+struct{
+	uint8 Buffer[OMAROS_CONSOLE_BUFFER_SIZE];
+	uint32 Write;
+	uint32 Read;
+	Console_stats Stats;
+	Task_ref ServiceTask;
+}Console_Control;
+
+/* Copies "Length" buffered bytes starting at "Position" out of the ring (at most one wrap) */
+static void OmarOS_ConsoleCopy(uint8* pDestination, uint32 Position, uint32 Length){
+	uint32 Offset = Position & OMAROS_CONSOLE_MASK;
+	uint32 First = OMAROS_CONSOLE_BUFFER_SIZE - Offset;
+
+	if(First > Length){
+		First = Length;
+	}
+	STRING_memory_copy(&Console_Control.Buffer[Offset], pDestination, First);
+	STRING_memory_copy(&Console_Control.Buffer[0], pDestination + First, Length - First);
+}
+
+/* Sends chunks while there is something buffered, then sleeps. The empty check and the terminate
+ * are done with the scheduler suspended, a writer can't slip in between and miss the wake up. The
+ * self terminate is allowed by OmarOS_SuspendScheduler: a single level of suspension, resumed right after */
+static void OmarOS_ConsoleService(void){
+	uint8 Chunk[OMAROS_CONSOLE_CHUNK_SIZE];
+	uint32 Length;
+
+	while(1){
+		OmarOS_SuspendScheduler();
+		Length = Console_Control.Write - Console_Control.Read;
+		if(Length == 0){
+			OmarOS_TerminateTask(&Console_Control.ServiceTask);
+			/* The switch is pended until here, running again after the next write */
+			OmarOS_ResumeScheduler();
+			continue;
+		}
+		if(Length > OMAROS_CONSOLE_CHUNK_SIZE){
+			Length = OMAROS_CONSOLE_CHUNK_SIZE;
+		}
+		OmarOS_ConsoleCopy(Chunk, Console_Control.Read, Length);
+		Console_Control.Read += Length;
+		OmarOS_ResumeScheduler();
+
+		/* The slow part runs with the scheduler (and the buffer) free */
+		OmarOS_ConsoleOutput(Chunk, Length);
+		Console_Control.Stats.Sent += Length;
+	}
+}
+
+/**=============================================
+ * @Fn			- OmarOS_ConsoleWrite
+ * @brief 		- Buffers "Length" bytes for the console task
+ * @param [in] 	- pData: Pointer to the bytes
+ * @param [in] 	- Length: Number of bytes
+ * @retval 		- Length, bytes dropped on overflow are counted in Console_stats.Dropped
+ * Note			- Called by _write. Before OmarOS_StartOS, from ISRs and from the console task itself
+ * 				  the bytes are sent right away with OmarOS_ConsoleOutput
+ */
+int OmarOS_ConsoleWrite(const char* pData, int Length){
+	Task_ref* pTask = OmarOS_GetCurrentTask();
+	const uint8* pBytes = (const uint8*)pData;
+	uint32 Remaining, Free, Count, Offset, First;
+
+	if((pData == NULL) || (Length <= 0)){
+		return 0;
+	}
+
+	/* No task to wake (or none to switch to), nothing can be buffered */
+	if((pTask == NULL) || (pTask == &Console_Control.ServiceTask) || (__get_IPSR() != 0)){
+		Console_Control.Stats.Direct += (uint32)Length;
+		OmarOS_ConsoleOutput(pBytes, (uint32)Length);
+		return Length;
+	}
+
+	Remaining = (uint32)Length;
+	while(Remaining != 0){
+		OmarOS_SuspendScheduler();
+		Free = OMAROS_CONSOLE_BUFFER_SIZE - (Console_Control.Write - Console_Control.Read);
+		Count = Remaining;
+#if (OMAROS_CONSOLE_OVERFLOW == OMAROS_CONSOLE_OVERWRITE)
+		/* Only the newest OMAROS_CONSOLE_BUFFER_SIZE bytes can be kept, the oldest buffered ones make room */
+		if(Count > OMAROS_CONSOLE_BUFFER_SIZE){
+			Console_Control.Stats.Dropped += Count - OMAROS_CONSOLE_BUFFER_SIZE;
+			pBytes += Count - OMAROS_CONSOLE_BUFFER_SIZE;
+			Count = OMAROS_CONSOLE_BUFFER_SIZE;
+			Remaining = OMAROS_CONSOLE_BUFFER_SIZE;
+		}
+		if(Count > Free){
+			Console_Control.Read += Count - Free;
+			Console_Control.Stats.Dropped += Count - Free;
+		}
+#else
+		if(Count > Free){
+			Count = Free;
+		}
+#endif
+
+		/* Copy in at most two parts around the end of the ring */
+		Offset = Console_Control.Write & OMAROS_CONSOLE_MASK;
+		First = OMAROS_CONSOLE_BUFFER_SIZE - Offset;
+		if(First > Count){
+			First = Count;
+		}
+		STRING_memory_copy(pBytes, &Console_Control.Buffer[Offset], First);
+		STRING_memory_copy(pBytes + First, &Console_Control.Buffer[0], Count - First);
+		Console_Control.Write += Count;
+		Console_Control.Stats.Written += Count;
+		if((Console_Control.Write - Console_Control.Read) > Console_Control.Stats.MaxUsed){
+			Console_Control.Stats.MaxUsed = Console_Control.Write - Console_Control.Read;
+		}
+		pBytes += Count;
+		Remaining -= Count;
+
+		/* Lower priority than the writers, it runs once they are done */
+		if((Count != 0) && (Console_Control.ServiceTask.TaskState == Suspended)){
+			OmarOS_ActivateTask(&Console_Control.ServiceTask);
+		}
+		OmarOS_ResumeScheduler();
+
+		if(Remaining != 0){
+#if (OMAROS_CONSOLE_OVERFLOW == OMAROS_CONSOLE_BLOCK)
+			/* Let the console task make room */
+			Console_Control.Stats.Blocked++;
+			OmarOS_TaskWait(1, pTask);
+#else
+			Console_Control.Stats.Dropped += Remaining;
+			Remaining = 0;
+#endif
+		}
+	}
+
+	return Length;
+}
+
+/**=============================================
+ * @Fn			- OmarOS_ConsoleOutput
+ * @brief 		- Sends bytes to the console device
+ * @param [in] 	- pData: Pointer to the bytes
+ * @param [in] 	- Length: Number of bytes
+ * @retval 		- None
+ * Note			- Weak, calls __io_putchar for every byte. Can be replaced by a driver that starts a DMA
+ * 				  transfer and waits for its completion interrupt, the console task is the only caller
+ * 				  once the OS runs
+ */
+__attribute__((weak)) void OmarOS_ConsoleOutput(const uint8* pData, uint32 Length){
+	uint32 index;
+
+	if(__io_putchar != NULL){
+		for(index = 0; index < Length; index++){
+			__io_putchar(pData[index]);
+		}
+	}
+}
+
+/**=============================================
+ * @Fn			- OmarOS_ConsoleGetStats
+ * @brief 		- Reports the console counters
+ * @param [out] - pStats: Pointer to the structure to be filled
+ * @retval 		- None
+ * Note			- None
+ */
+void OmarOS_ConsoleGetStats(Console_stats* pStats){
+	OmarOS_SuspendScheduler();
+	*pStats = Console_Control.Stats;
+	OmarOS_ResumeScheduler();
+}
+
+/**=============================================
+ * @Fn			- OmarOS_ConsoleInit
+ * @brief 		- Empties the console buffer and creates the console task
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- Called by OmarOS_Init
+ */
+OmarOS_errorTypes OmarOS_ConsoleInit(void){
+	Console_Control.Write = 0;
+	Console_Control.Read = 0;
+	STRING_set_memoryLocation((uint8*)&Console_Control.Stats, 0, sizeof(Console_Control.Stats));
+	Console_Control.ServiceTask.pConfig = &CONSOLE_TASK_CONFIG;
+	return OmarOS_CreateTask(&Console_Control.ServiceTask);
+}
+
+#endif
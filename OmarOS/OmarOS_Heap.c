@@ -0,0 +1,629 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_Heap.c 			                             */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+#include "OmarOS_Heap.h"
+
+/*
+ * Two Level Segregated Fit
+ * ========================
+ * Free blocks are kept in FL x SL segregated lists, the first level splits sizes by powers of 2
+ * and the second level splits every power of 2 in SL equal ranges. Two bitmaps tell which lists
+ * are not empty, so finding a suitable block is a couple of CLZ instructions whatever the heap state.
+ *
+ * Block layout
+ * ============
+ * pPrevPhys	: Previous block in memory (used to merge with it on free)
+ * Size			: Whole block size including the header, bit 0 set when the block is free
+ * pOwner		: Task that allocated the block (only with HEAP_TASK_QUOTAS)
+ * ------------ : User data starts here
+ * pNextFree	: Free list links, only valid while the block is free
+ * pPrevFree
+ */
+typedef struct Heap_Block{
+	struct Heap_Block* pPrevPhys;
+	uint32 Size;
+#if (HEAP_TASK_QUOTAS == 1)
+	Task_ref* pOwner;
+	uint32 Reserved;
+#endif
+	struct Heap_Block* pNextFree;
+	struct Heap_Block* pPrevFree;
+}Heap_Block;
+
+#define HEAP_ALIGN_LOG2			3
+#define HEAP_ALIGN				(1UL << HEAP_ALIGN_LOG2)
+#define HEAP_ALIGN_UP(x)		(((x) + (HEAP_ALIGN - 1)) & ~(HEAP_ALIGN - 1))
+
+#define HEAP_BLOCK_FREE			0x1UL
+#define HEAP_SIZE_MASK			(~(HEAP_ALIGN - 1))
+
+#define HEAP_HEADER_SIZE		HEAP_ALIGN_UP((uint32)&(((Heap_Block*)0)->pNextFree))
+#define HEAP_MIN_BLOCK_SIZE		HEAP_ALIGN_UP(sizeof(Heap_Block))
+
+#define HEAP_SL_INDEX_COUNT		(1UL << HEAP_SL_INDEX_COUNT_LOG2)
+#define HEAP_FL_INDEX_SHIFT		(HEAP_SL_INDEX_COUNT_LOG2 + HEAP_ALIGN_LOG2)
+#define HEAP_FL_INDEX_COUNT		(HEAP_FL_INDEX_MAX - HEAP_FL_INDEX_SHIFT + 1)
+#define HEAP_SMALL_BLOCK_SIZE	(1UL << HEAP_FL_INDEX_SHIFT)
+
+/* Absolute symbol holding 2^HEAP_FL_INDEX_MAX, the linker script checks the heap region against it */
+#define HEAP_STRINGIFY(x)		#x
+#define HEAP_TO_STRING(x)		HEAP_STRINGIFY(x)
+__asm__(".global OmarOS_HeapMaxSize\n\t.equ OmarOS_HeapMaxSize, (1 << " HEAP_TO_STRING(HEAP_FL_INDEX_MAX) ")");
+
+static struct{
+	uint32 FL_Bitmap;
+	uint32 SL_Bitmap[HEAP_FL_INDEX_COUNT];
+	Heap_Block* FreeLists[HEAP_FL_INDEX_COUNT][HEAP_SL_INDEX_COUNT];
+
+	uint8* pStart;
+	uint8* pEnd;
+
+	uint32 TotalSize;
+	uint32 FreeSize;
+	uint32 MinEverFreeSize;
+	uint32 NoOfFreeBlocks;
+	uint32 NoOfUsedBlocks;
+	uint32 FailedAllocations;
+}Heap_Control;
+
+static uint32 Heap_fls(uint32 Value){
+	return (31 - __CLZ(Value));
+}
+
+static uint32 Heap_ffs(uint32 Value){
+	return Heap_fls(Value & (~Value + 1));
+}
+
+static uint32 Heap_BlockSize(const Heap_Block* pBlock){
+	return (pBlock->Size & HEAP_SIZE_MASK);
+}
+
+static Heap_Block* Heap_NextPhys(const Heap_Block* pBlock){
+	return (Heap_Block*)((uint8*)pBlock + Heap_BlockSize(pBlock));
+}
+
+/* Gets the list a block of "Size" bytes belongs to */
+static void Heap_MappingInsert(uint32 Size, uint32* pFL, uint32* pSL){
+	uint32 fl;
+	if(Size < HEAP_SMALL_BLOCK_SIZE){
+		*pFL = 0;
+		*pSL = Size >> HEAP_ALIGN_LOG2;
+	}
+	else{
+		fl = Heap_fls(Size);
+		*pSL = (Size >> (fl - HEAP_SL_INDEX_COUNT_LOG2)) ^ HEAP_SL_INDEX_COUNT;
+		*pFL = fl - (HEAP_FL_INDEX_SHIFT - 1);
+	}
+}
+
+/* Gets the first list whose blocks are all big enough for "Size" bytes */
+static void Heap_MappingSearch(uint32 Size, uint32* pFL, uint32* pSL){
+	if(Size >= HEAP_SMALL_BLOCK_SIZE){
+		Size += (1UL << (Heap_fls(Size) - HEAP_SL_INDEX_COUNT_LOG2)) - 1;
+	}
+	Heap_MappingInsert(Size, pFL, pSL);
+}
+
+static void Heap_InsertFree(Heap_Block* pBlock){
+	uint32 fl, sl;
+	Heap_MappingInsert(Heap_BlockSize(pBlock), &fl, &sl);
+
+	pBlock->Size |= HEAP_BLOCK_FREE;
+	pBlock->pPrevFree = NULL;
+	pBlock->pNextFree = Heap_Control.FreeLists[fl][sl];
+	if(pBlock->pNextFree != NULL){
+		pBlock->pNextFree->pPrevFree = pBlock;
+	}
+	Heap_Control.FreeLists[fl][sl] = pBlock;
+
+	Heap_Control.FL_Bitmap |= (1UL << fl);
+	Heap_Control.SL_Bitmap[fl] |= (1UL << sl);
+
+	Heap_Control.FreeSize += Heap_BlockSize(pBlock);
+	Heap_Control.NoOfFreeBlocks++;
+}
+
+static void Heap_RemoveFree(Heap_Block* pBlock){
+	uint32 fl, sl;
+	Heap_MappingInsert(Heap_BlockSize(pBlock), &fl, &sl);
+
+	if(pBlock->pNextFree != NULL){
+		pBlock->pNextFree->pPrevFree = pBlock->pPrevFree;
+	}
+	if(pBlock->pPrevFree != NULL){
+		pBlock->pPrevFree->pNextFree = pBlock->pNextFree;
+	}
+	else{
+		/* Block was the list head */
+		Heap_Control.FreeLists[fl][sl] = pBlock->pNextFree;
+		if(pBlock->pNextFree == NULL){
+			Heap_Control.SL_Bitmap[fl] &= ~(1UL << sl);
+			if(Heap_Control.SL_Bitmap[fl] == 0){
+				Heap_Control.FL_Bitmap &= ~(1UL << fl);
+			}
+		}
+	}
+	pBlock->Size &= ~HEAP_BLOCK_FREE;
+
+	Heap_Control.FreeSize -= Heap_BlockSize(pBlock);
+	Heap_Control.NoOfFreeBlocks--;
+}
+
+static Heap_Block* Heap_FindSuitable(uint32 Size){
+	uint32 fl, sl, sl_map, fl_map;
+
+	Heap_MappingSearch(Size, &fl, &sl);
+	if(fl >= HEAP_FL_INDEX_COUNT){
+		return NULL;
+	}
+
+	/* Search the second level for a non empty list of big enough blocks */
+	sl_map = Heap_Control.SL_Bitmap[fl] & (~0UL << sl);
+	if(sl_map == 0){
+		/* Nothing in this first level, move to the next non empty one */
+		fl_map = (fl + 1 < 32) ? (Heap_Control.FL_Bitmap & (~0UL << (fl + 1))) : 0;
+		if(fl_map == 0){
+			return NULL;
+		}
+		fl = Heap_ffs(fl_map);
+		sl_map = Heap_Control.SL_Bitmap[fl];
+	}
+	sl = Heap_ffs(sl_map);
+
+	return Heap_Control.FreeLists[fl][sl];
+}
+
+/* Cuts the tail of a used block into a new free block if it is big enough */
+static void Heap_Trim(Heap_Block* pBlock, uint32 Size){
+	Heap_Block *pRemain, *pNext;
+	uint32 BlockSize = Heap_BlockSize(pBlock);
+
+	if(BlockSize >= (Size + HEAP_MIN_BLOCK_SIZE)){
+		pRemain = (Heap_Block*)((uint8*)pBlock + Size);
+		pRemain->Size = BlockSize - Size;
+		pRemain->pPrevPhys = pBlock;
+		pBlock->Size = Size | (pBlock->Size & HEAP_BLOCK_FREE);
+
+		pNext = Heap_NextPhys(pRemain);
+		if(pNext->Size & HEAP_BLOCK_FREE){
+			/* Merge the remainder with the free block after it */
+			Heap_RemoveFree(pNext);
+			pRemain->Size += Heap_BlockSize(pNext);
+			pNext = Heap_NextPhys(pRemain);
+		}
+		pNext->pPrevPhys = pRemain;
+
+		Heap_InsertFree(pRemain);
+	}
+}
+
+/* Size a free block of "Size" bytes keeps once Heap_Trim cut it to "Request", what its owner is charged */
+static uint32 Heap_TrimmedSize(uint32 Size, uint32 Request){
+	return (Size >= (Request + HEAP_MIN_BLOCK_SIZE)) ? Request : Size;
+}
+
+static uint32 Heap_RequestToBlockSize(uint32 Size){
+	uint32 BlockSize;
+	/* Reject sizes that would overflow the header and alignment arithmetic */
+	if(Size > ((uint32)1 << HEAP_FL_INDEX_MAX)){
+		return 0;
+	}
+	BlockSize = HEAP_ALIGN_UP(Size + HEAP_HEADER_SIZE);
+	if(BlockSize < HEAP_MIN_BLOCK_SIZE){
+		BlockSize = HEAP_MIN_BLOCK_SIZE;
+	}
+	return BlockSize;
+}
+
+#if (HEAP_TASK_QUOTAS == 1)
+static uint8 Heap_QuotaExceeded(const Task_ref* pOwner, uint32 BlockSize){
+	return (pOwner != NULL) && (pOwner->pConfig->HeapQuota != 0) && ((pOwner->HeapUsed + BlockSize) > pOwner->pConfig->HeapQuota);
+}
+#endif
+
+/**=============================================
+ * @Fn			- OmarOS_HeapInit
+ * @brief 		- Hands a memory region to the heap
+ * @param [in] 	- pStart: Start address of the region
+ * @param [in] 	- Size: Size of the region in bytes
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- The newlib malloc family initializes the heap between _end and _eheap on first use
+ * 				  Only the first 2^HEAP_FL_INDEX_MAX bytes of a bigger region are used, see OmarOS_HeapGetStats TotalSize
+ */
+OmarOS_errorTypes OmarOS_HeapInit(void* pStart, uint32 Size){
+	Heap_Block *pBlock, *pSentinel;
+	uint32 fl, sl;
+	uint8* pEnd;
+
+	if(pStart == NULL){
+		return HeapInvalidRegion;
+	}
+
+	/* Align both ends of the region */
+	pEnd = (uint8*)(((uint32)pStart + Size) & HEAP_SIZE_MASK);
+	pStart = (void*)HEAP_ALIGN_UP((uint32)pStart);
+	if(pEnd < ((uint8*)pStart + HEAP_MIN_BLOCK_SIZE + HEAP_HEADER_SIZE)){
+		return HeapInvalidRegion;
+	}
+
+	for(fl = 0; fl < HEAP_FL_INDEX_COUNT; fl++){
+		Heap_Control.SL_Bitmap[fl] = 0;
+		for(sl = 0; sl < HEAP_SL_INDEX_COUNT; sl++){
+			Heap_Control.FreeLists[fl][sl] = NULL;
+		}
+	}
+	Heap_Control.FL_Bitmap = 0;
+	Heap_Control.pStart = (uint8*)pStart;
+	Heap_Control.pEnd = pEnd;
+	Heap_Control.FreeSize = 0;
+	Heap_Control.NoOfFreeBlocks = 0;
+	Heap_Control.NoOfUsedBlocks = 0;
+	Heap_Control.FailedAllocations = 0;
+
+	/* One free block covering the region, followed by a used zero sized sentinel that stops merges */
+	pBlock = (Heap_Block*)pStart;
+	pBlock->pPrevPhys = NULL;
+	pBlock->Size = (uint32)(pEnd - (uint8*)pStart) - HEAP_HEADER_SIZE;
+	if(pBlock->Size >= ((uint32)1 << HEAP_FL_INDEX_MAX)){
+		/* Region is bigger than the biggest block the lists can hold */
+		pBlock->Size = ((uint32)1 << HEAP_FL_INDEX_MAX) - HEAP_ALIGN;
+	}
+
+	pSentinel = Heap_NextPhys(pBlock);
+	pSentinel->pPrevPhys = pBlock;
+	pSentinel->Size = 0;
+
+	Heap_Control.TotalSize = Heap_BlockSize(pBlock);
+	Heap_InsertFree(pBlock);
+	Heap_Control.MinEverFreeSize = Heap_Control.FreeSize;
+
+	return noError;
+}
+
+/**=============================================
+ * @Fn			- OmarOS_HeapAlloc
+ * @brief 		- Allocates a block of at least "Size" bytes in constant time
+ * @param [in] 	- Size: Number of bytes requested
+ * @retval 		- Pointer to 8 bytes aligned memory or NULL if the request can't be satisfied
+ * Note			- Safe to call from different tasks, must not be called from ISRs (use memory pools instead)
+ */
+void* OmarOS_HeapAlloc(uint32 Size){
+	Heap_Block* pBlock = NULL;
+	uint32 BlockSize;
+
+	if(Size == 0){
+		return NULL;
+	}
+	BlockSize = Heap_RequestToBlockSize(Size);
+
+	OmarOS_SuspendScheduler();
+
+	if(BlockSize != 0){
+		pBlock = Heap_FindSuitable(BlockSize);
+	}
+
+#if (HEAP_TASK_QUOTAS == 1)
+	Task_ref* pOwner = OmarOS_GetCurrentTask();
+	if((pBlock != NULL) && Heap_QuotaExceeded(pOwner, Heap_TrimmedSize(Heap_BlockSize(pBlock), BlockSize))){
+		pBlock = NULL;
+	}
+#endif
+
+	if(pBlock != NULL){
+		Heap_RemoveFree(pBlock);
+		Heap_Trim(pBlock, BlockSize);
+		Heap_Control.NoOfUsedBlocks++;
+		if(Heap_Control.FreeSize < Heap_Control.MinEverFreeSize){
+			Heap_Control.MinEverFreeSize = Heap_Control.FreeSize;
+		}
+#if (HEAP_TASK_QUOTAS == 1)
+		pBlock->pOwner = pOwner;
+		if(pOwner != NULL){
+			pOwner->HeapUsed += Heap_BlockSize(pBlock);
+		}
+#endif
+	}
+	else{
+		Heap_Control.FailedAllocations++;
+	}
+
+	OmarOS_ResumeScheduler();
+
+	return (pBlock != NULL) ? ((uint8*)pBlock + HEAP_HEADER_SIZE) : NULL;
+}
+
+/**=============================================
+ * @Fn			- OmarOS_HeapAllocAligned
+ * @brief 		- Allocates a block of at least "Size" bytes whose address is a multiple of "Alignment"
+ * @param [in] 	- Alignment: Power of 2, 8 or less gives the same block as OmarOS_HeapAlloc
+ * @param [in] 	- Size: Number of bytes requested
+ * @retval 		- Pointer to the aligned memory or NULL if the request can't be satisfied
+ * Note			- Safe to call from different tasks, must not be called from ISRs
+ * 				  The space in front of the aligned address goes back to the heap as a free block
+ */
+void* OmarOS_HeapAllocAligned(uint32 Alignment, uint32 Size){
+	Heap_Block *pBlock = NULL, *pAligned;
+	uint32 BlockSize, Gap = 0;
+	uint8* pData = NULL;
+
+	if((Alignment & (Alignment - 1)) != 0){
+		return NULL;
+	}
+	if(Alignment <= HEAP_ALIGN){
+		return OmarOS_HeapAlloc(Size);
+	}
+	if((Size == 0) || (Alignment > ((uint32)1 << HEAP_FL_INDEX_MAX))){
+		return NULL;
+	}
+	BlockSize = Heap_RequestToBlockSize(Size);
+	if(BlockSize == 0){
+		return NULL;
+	}
+
+	OmarOS_SuspendScheduler();
+
+	/* Big enough for the block behind a free block of at least HEAP_MIN_BLOCK_SIZE in front of it */
+	pBlock = Heap_FindSuitable(BlockSize + Alignment + HEAP_MIN_BLOCK_SIZE);
+	if(pBlock != NULL){
+		pData = (uint8*)(((uint32)pBlock + HEAP_HEADER_SIZE + (Alignment - 1)) & ~(Alignment - 1));
+		Gap = (uint32)(pData - (uint8*)pBlock) - HEAP_HEADER_SIZE;
+		while((Gap != 0) && (Gap < HEAP_MIN_BLOCK_SIZE)){
+			pData += Alignment;
+			Gap += Alignment;
+		}
+	}
+
+#if (HEAP_TASK_QUOTAS == 1)
+	Task_ref* pOwner = OmarOS_GetCurrentTask();
+	if((pBlock != NULL) && Heap_QuotaExceeded(pOwner, Heap_TrimmedSize(Heap_BlockSize(pBlock) - Gap, BlockSize))){
+		pBlock = NULL;
+	}
+#endif
+
+	if(pBlock != NULL){
+		Heap_RemoveFree(pBlock);
+		if(Gap != 0){
+			/* The front becomes a free block, the one before it is used since free neighbours are always merged */
+			pAligned = (Heap_Block*)(pData - HEAP_HEADER_SIZE);
+			pAligned->pPrevPhys = pBlock;
+			pAligned->Size = Heap_BlockSize(pBlock) - Gap;
+			Heap_NextPhys(pAligned)->pPrevPhys = pAligned;
+			pBlock->Size = Gap;
+			Heap_InsertFree(pBlock);
+			pBlock = pAligned;
+		}
+		Heap_Trim(pBlock, BlockSize);
+		Heap_Control.NoOfUsedBlocks++;
+		if(Heap_Control.FreeSize < Heap_Control.MinEverFreeSize){
+			Heap_Control.MinEverFreeSize = Heap_Control.FreeSize;
+		}
+#if (HEAP_TASK_QUOTAS == 1)
+		pBlock->pOwner = pOwner;
+		if(pOwner != NULL){
+			pOwner->HeapUsed += Heap_BlockSize(pBlock);
+		}
+#endif
+	}
+	else{
+		Heap_Control.FailedAllocations++;
+	}
+
+	OmarOS_ResumeScheduler();
+
+	return (pBlock != NULL) ? ((uint8*)pBlock + HEAP_HEADER_SIZE) : NULL;
+}
+
+/**=============================================
+ * @Fn			- OmarOS_HeapFree
+ * @brief 		- Returns a block to the heap in constant time and merges it with its free neighbours
+ * @param [in] 	- pBlock: Pointer returned by OmarOS_HeapAlloc, NULL is ignored
+ * @retval 		- None
+ * Note			- Safe to call from different tasks, must not be called from ISRs (use memory pools instead)
+ */
+void OmarOS_HeapFree(void* pBlock){
+	Heap_Block *pFree, *pPrev, *pNext;
+
+	if(((uint8*)pBlock < (Heap_Control.pStart + HEAP_HEADER_SIZE)) || ((uint8*)pBlock >= Heap_Control.pEnd)){
+		return;
+	}
+	pFree = (Heap_Block*)((uint8*)pBlock - HEAP_HEADER_SIZE);
+
+	OmarOS_SuspendScheduler();
+
+	/* Ignore blocks that are already free */
+	if(!(pFree->Size & HEAP_BLOCK_FREE)){
+		Heap_Control.NoOfUsedBlocks--;
+#if (HEAP_TASK_QUOTAS == 1)
+		if(pFree->pOwner != NULL){
+			pFree->pOwner->HeapUsed -= Heap_BlockSize(pFree);
+		}
+#endif
+
+		/* Merge with the previous block */
+		pPrev = pFree->pPrevPhys;
+		if((pPrev != NULL) && (pPrev->Size & HEAP_BLOCK_FREE)){
+			Heap_RemoveFree(pPrev);
+			pPrev->Size += Heap_BlockSize(pFree);
+			pFree = pPrev;
+		}
+
+		/* Merge with the next block */
+		pNext = Heap_NextPhys(pFree);
+		if(pNext->Size & HEAP_BLOCK_FREE){
+			Heap_RemoveFree(pNext);
+			pFree->Size += Heap_BlockSize(pNext);
+			pNext = Heap_NextPhys(pFree);
+		}
+		pNext->pPrevPhys = pFree;
+
+		Heap_InsertFree(pFree);
+	}
+
+	OmarOS_ResumeScheduler();
+}
+
+/**=============================================
+ * @Fn			- OmarOS_HeapRealloc
+ * @brief 		- Resizes a block, growing in place when the next block is free
+ * @param [in] 	- pBlock: Pointer returned by OmarOS_HeapAlloc or NULL
+ * @param [in] 	- Size: New size in bytes
+ * @retval 		- Pointer to the resized block, or NULL if the request can't be satisfied or pBlock is not in the heap (pBlock is kept)
+ * Note			- Safe to call from different tasks, must not be called from ISRs
+ */
+void* OmarOS_HeapRealloc(void* pBlock, uint32 Size){
+	Heap_Block *pUsed, *pNext;
+	uint32 BlockSize, OldSize, GrownSize;
+	void* pNew = NULL;
+
+	if(pBlock == NULL){
+		return OmarOS_HeapAlloc(Size);
+	}
+	if(((uint8*)pBlock < (Heap_Control.pStart + HEAP_HEADER_SIZE)) || ((uint8*)pBlock >= Heap_Control.pEnd)){
+		return NULL;
+	}
+	if(Size == 0){
+		OmarOS_HeapFree(pBlock);
+		return NULL;
+	}
+	BlockSize = Heap_RequestToBlockSize(Size);
+	if(BlockSize == 0){
+		return NULL;
+	}
+
+	pUsed = (Heap_Block*)((uint8*)pBlock - HEAP_HEADER_SIZE);
+
+	OmarOS_SuspendScheduler();
+
+	OldSize = Heap_BlockSize(pUsed);
+	pNext = Heap_NextPhys(pUsed);
+
+	/* Size of the block once the next one is absorbed and the rest trimmed, what the owner is charged */
+	GrownSize = Heap_TrimmedSize(OldSize + Heap_BlockSize(pNext), BlockSize);
+
+	if(OldSize >= BlockSize){
+		/* Already big enough */
+		pNew = pBlock;
+	}
+	else if((pNext->Size & HEAP_BLOCK_FREE) && (GrownSize >= BlockSize)
+#if (HEAP_TASK_QUOTAS == 1)
+			&& !Heap_QuotaExceeded(pUsed->pOwner, GrownSize - OldSize)
+#endif
+			){
+		/* Absorb the next free block and give back what is not needed */
+		Heap_RemoveFree(pNext);
+		pUsed->Size += Heap_BlockSize(pNext);
+		Heap_NextPhys(pUsed)->pPrevPhys = pUsed;
+		Heap_Trim(pUsed, BlockSize);
+		if(Heap_Control.FreeSize < Heap_Control.MinEverFreeSize){
+			Heap_Control.MinEverFreeSize = Heap_Control.FreeSize;
+		}
+#if (HEAP_TASK_QUOTAS == 1)
+		if(pUsed->pOwner != NULL){
+			pUsed->pOwner->HeapUsed += GrownSize - OldSize;
+		}
+#endif
+		pNew = pBlock;
+	}
+
+	OmarOS_ResumeScheduler();
+
+	if(pNew == NULL){
+		/* Move the data to a new block */
+		pNew = OmarOS_HeapAlloc(Size);
+		if(pNew != NULL){
+			STRING_memory_copy(pBlock, pNew, OldSize - HEAP_HEADER_SIZE);
+			OmarOS_HeapFree(pBlock);
+		}
+	}
+
+	return pNew;
+}
+
+#if (HEAP_TASK_QUOTAS == 1)
+/**=============================================
+ * @Fn			- OmarOS_HeapReleaseOwner
+ * @brief 		- Detaches the blocks of a deleted task from it, they stay allocated but no longer count against a quota
+ * @param [in] 	- pTask: Pointer to the deleted task
+ * @retval 		- None
+ * Note			- Walks every block, called by the scheduler once a task is deleted (only with HEAP_TASK_QUOTAS)
+ */
+void OmarOS_HeapReleaseOwner(Task_ref* pTask){
+	Heap_Block* pBlock;
+
+	if(Heap_Control.pStart == NULL){
+		return;
+	}
+
+	OmarOS_SuspendScheduler();
+
+	/* The zero sized sentinel ends the walk */
+	for(pBlock = (Heap_Block*)Heap_Control.pStart; Heap_BlockSize(pBlock) != 0; pBlock = Heap_NextPhys(pBlock)){
+		if(!(pBlock->Size & HEAP_BLOCK_FREE) && (pBlock->pOwner == pTask)){
+			pBlock->pOwner = NULL;
+		}
+	}
+	pTask->HeapUsed = 0;
+
+	OmarOS_ResumeScheduler();
+}
+#endif
+
+/**=============================================
+ * @Fn			- OmarOS_HeapUsableSize
+ * @brief 		- Returns how many bytes of an allocated block can be used, at least the size requested
+ * @param [in] 	- pBlock: Pointer returned by OmarOS_HeapAlloc, OmarOS_HeapAllocAligned or OmarOS_HeapRealloc
+ * @retval 		- Usable bytes, 0 if pBlock is NULL, not in the heap or free
+ * Note			- None
+ */
+uint32 OmarOS_HeapUsableSize(void* pBlock){
+	const Heap_Block* pUsed;
+
+	if(((uint8*)pBlock < (Heap_Control.pStart + HEAP_HEADER_SIZE)) || ((uint8*)pBlock >= Heap_Control.pEnd)){
+		return 0;
+	}
+	pUsed = (const Heap_Block*)((uint8*)pBlock - HEAP_HEADER_SIZE);
+
+	return (pUsed->Size & HEAP_BLOCK_FREE) ? 0 : (Heap_BlockSize(pUsed) - HEAP_HEADER_SIZE);
+}
+
+/**=============================================
+ * @Fn			- OmarOS_HeapGetStats
+ * @brief 		- Reports heap usage and fragmentation
+ * @param [out] - pStats: Pointer to the structure to be filled
+ * @retval 		- None
+ * Note			- Walks the free lists, so it is not constant time
+ */
+void OmarOS_HeapGetStats(Heap_stats* pStats){
+	Heap_Block* pBlock;
+	uint32 fl, sl, Largest = 0;
+
+	OmarOS_SuspendScheduler();
+
+	/* The biggest free block is in the highest non empty list */
+	if(Heap_Control.FL_Bitmap != 0){
+		fl = Heap_fls(Heap_Control.FL_Bitmap);
+		sl = Heap_fls(Heap_Control.SL_Bitmap[fl]);
+		for(pBlock = Heap_Control.FreeLists[fl][sl]; pBlock != NULL; pBlock = pBlock->pNextFree){
+			if(Heap_BlockSize(pBlock) > Largest){
+				Largest = Heap_BlockSize(pBlock);
+			}
+		}
+	}
+
+	pStats->TotalSize = Heap_Control.TotalSize;
+	pStats->FreeSize = Heap_Control.FreeSize;
+	pStats->MinEverFreeSize = Heap_Control.MinEverFreeSize;
+	pStats->LargestFreeBlock = (Largest > HEAP_HEADER_SIZE) ? (Largest - HEAP_HEADER_SIZE) : 0;
+	pStats->NoOfFreeBlocks = Heap_Control.NoOfFreeBlocks;
+	pStats->NoOfUsedBlocks = Heap_Control.NoOfUsedBlocks;
+	pStats->FailedAllocations = Heap_Control.FailedAllocations;
+	pStats->Fragmentation = (Heap_Control.FreeSize != 0) ? (uint8)(100 - ((Largest * 100) / Heap_Control.FreeSize)) : 0;
+
+	OmarOS_ResumeScheduler();
+}
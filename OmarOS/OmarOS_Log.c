@@ -0,0 +1,298 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_Log.c 			                             */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+#include "OmarOS_Log.h"
+
+#if (OMAROS_USE_LOG == 1)
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Record layout in the ring buffer, in pointer sized words (32 bits on the target):
+ * 		[0] Header: OMAROS_LOG_VALID | NoOfArgs << 28 | low 28 bits of the tick count
+ * 		[1] Format string address
+ * 		[2] Arguments
+ * A record may wrap around the end of the buffer. The header is written last and read first, it is
+ * 0 while the record is reserved but not complete. The reader clears every word it takes so the
+ * next record written there starts with a 0 header.
+ */
+#define OMAROS_LOG_BUFFER_WORDS		(OMAROS_LOG_BUFFER_SIZE / sizeof(uintptr_t))
+#define OMAROS_LOG_MASK				(OMAROS_LOG_BUFFER_WORDS - 1)
+#define OMAROS_LOG_VALID			0x80000000UL
+#define OMAROS_LOG_ARGS_SHIFT		28
+#define OMAROS_LOG_TICK_MASK		0x0FFFFFFFUL
+#define OMAROS_LOG_RECORD_WORDS(NoOfArgs)	(2 + (NoOfArgs))
+
+/* Longest conversion OmarOS_LogPrint handles, like "%-08.3x" */
+#define OMAROS_LOG_CONVERSION_SIZE	16
+
+static void OmarOS_LogWrite(const char* Format, uint32 NoOfArgs, const uintptr_t* pArgs);
+#if (OMAROS_LOG_TASK == 1)
+static void OmarOS_LogService(void);
+
+static const Task_Config LOG_TASK_CONFIG = {
+	OMAROS_TASK_NAME("logtask"),
+	.pf_TaskEntry = OmarOS_LogService,
+	.Stack_Size = OMAROS_LOG_STACK_SIZE,
+	.Priority = OMAROS_LOG_TASK_PRIORITY,
+	.AutoStart = Autostart_Enabled
+};
+#endif
+
+struct{
+	volatile uintptr_t Buffer[OMAROS_LOG_BUFFER_WORDS];
+	volatile uint32 Write;	/* Free running word indexes, Write is reserved with LDREX/STREX */
+	volatile uint32 Read;	/* Only moved by the reader */
+	volatile uint32 Dropped;
+	uint32 NoOfRead;
+#if (OMAROS_USE_STATS == 1)
+	volatile uint32 MaxUsed;
+#endif
+#if (OMAROS_LOG_TASK == 1)
+	Task_ref ServiceTask;
+#endif
+}Log_Control;
+
+/* Reserves the record with one exclusive access on the write index, then fills it. An exception
+ * between LDREX and STREX clears the monitor and the reservation is retried with the new index */
+static void OmarOS_LogWrite(const char* Format, uint32 NoOfArgs, const uintptr_t* pArgs){
+	uint32 Write, Used, index;
+	uint32 Size = OMAROS_LOG_RECORD_WORDS(NoOfArgs);
+
+	do{
+		Write = __LDREXW((volatile uint32_t*)&Log_Control.Write);
+		Used = (Write + Size) - Log_Control.Read;
+		if(Used > OMAROS_LOG_BUFFER_WORDS){
+			__CLREX();
+			/* Full: the record is dropped, the caller never waits for the reader */
+			do{
+				index = __LDREXW((volatile uint32_t*)&Log_Control.Dropped) + 1;
+			}while(__STREXW(index, (volatile uint32_t*)&Log_Control.Dropped) != 0);
+			return;
+		}
+	}while(__STREXW(Write + Size, (volatile uint32_t*)&Log_Control.Write) != 0);
+
+#if (OMAROS_USE_STATS == 1)
+	/* Only goes through the exclusive access when the high water mark moves */
+	while(Used > Log_Control.MaxUsed){
+		if(__LDREXW((volatile uint32_t*)&Log_Control.MaxUsed) >= Used){
+			__CLREX();
+			break;
+		}
+		if(__STREXW(Used, (volatile uint32_t*)&Log_Control.MaxUsed) == 0){
+			break;
+		}
+	}
+#endif
+
+	Log_Control.Buffer[(Write + 1) & OMAROS_LOG_MASK] = (uintptr_t)Format;
+	for(index = 0; index < NoOfArgs; index++){
+		Log_Control.Buffer[(Write + 2 + index) & OMAROS_LOG_MASK] = pArgs[index];
+	}
+
+	/* The record body must be in memory before the header makes it visible to the reader */
+	__DMB();
+	Log_Control.Buffer[Write & OMAROS_LOG_MASK] = OMAROS_LOG_VALID | (NoOfArgs << OMAROS_LOG_ARGS_SHIFT) |
+			(OmarOS_GetTickCount() & OMAROS_LOG_TICK_MASK);
+}
+
+/**=============================================
+ * @Fn			- OmarOS_Log0 ... OmarOS_Log4
+ * @brief 		- Stores a record with 0 to 4 arguments, called by OMAROS_LOG
+ * @param [in] 	- Format: Format string, must stay valid (a string literal)
+ * @param [in] 	- Arg1 ... Arg4: Arguments, OMAROS_LOG casts them to uintptr_t
+ * @retval 		- None
+ * Note			- Safe from tasks and ISRs, never blocks
+ */
+void OmarOS_Log0(const char* Format){
+	OmarOS_LogWrite(Format, 0, NULL);
+}
+
+void OmarOS_Log1(const char* Format, uintptr_t Arg1){
+	OmarOS_LogWrite(Format, 1, &Arg1);
+}
+
+void OmarOS_Log2(const char* Format, uintptr_t Arg1, uintptr_t Arg2){
+	uintptr_t Args[2] = { Arg1, Arg2 };
+	OmarOS_LogWrite(Format, 2, Args);
+}
+
+void OmarOS_Log3(const char* Format, uintptr_t Arg1, uintptr_t Arg2, uintptr_t Arg3){
+	uintptr_t Args[3] = { Arg1, Arg2, Arg3 };
+	OmarOS_LogWrite(Format, 3, Args);
+}
+
+void OmarOS_Log4(const char* Format, uintptr_t Arg1, uintptr_t Arg2, uintptr_t Arg3, uintptr_t Arg4){
+	uintptr_t Args[4] = { Arg1, Arg2, Arg3, Arg4 };
+	OmarOS_LogWrite(Format, 4, Args);
+}
+
+/**=============================================
+ * @Fn			- OmarOS_LogRead
+ * @brief 		- Takes the oldest record out of the log buffer
+ * @param [out] - pRecord: Pointer to the record to be filled
+ * @retval 		- Returns 1 if a record was taken, 0 if there was none
+ * Note			- A single reader only (the log task when OMAROS_LOG_TASK is 1)
+ * 				  A record still being written by a preempted task ends the read, it is taken next time
+ */
+uint8 OmarOS_LogRead(Log_record* pRecord){
+	uint32 Read = Log_Control.Read;
+	uint32 Header, index;
+
+	if(Read == Log_Control.Write){
+		return 0;
+	}
+	Header = Log_Control.Buffer[Read & OMAROS_LOG_MASK];
+	if((Header & OMAROS_LOG_VALID) == 0){
+		/* Reserved, not complete yet */
+		return 0;
+	}
+	__DMB();
+
+	pRecord->Tick = Header & OMAROS_LOG_TICK_MASK;
+	pRecord->NoOfArgs = (Header & ~OMAROS_LOG_VALID) >> OMAROS_LOG_ARGS_SHIFT;
+	pRecord->Format = (const char*)Log_Control.Buffer[(Read + 1) & OMAROS_LOG_MASK];
+	for(index = 0; index < pRecord->NoOfArgs; index++){
+		pRecord->Args[index] = Log_Control.Buffer[(Read + 2 + index) & OMAROS_LOG_MASK];
+	}
+	for(; index < OMAROS_LOG_MAX_ARGS; index++){
+		pRecord->Args[index] = 0;
+	}
+
+	/* Words are cleared before they are given back to the writers */
+	for(index = 0; index < OMAROS_LOG_RECORD_WORDS(pRecord->NoOfArgs); index++){
+		Log_Control.Buffer[(Read + index) & OMAROS_LOG_MASK] = 0;
+	}
+	__DMB();
+	Log_Control.Read = Read + OMAROS_LOG_RECORD_WORDS(pRecord->NoOfArgs);
+	Log_Control.NoOfRead++;
+
+	return 1;
+}
+
+/**=============================================
+ * @Fn			- OmarOS_LogPrint
+ * @brief 		- Prints a record as one line: the tick count, then the formatted message
+ * @param [in] 	- pRecord: Pointer to a record from OmarOS_LogRead
+ * @retval 		- None
+ * Note			- Uses printf once per conversion with the argument's own type, only called from a task
+ * 				  with a large enough stack
+ */
+void OmarOS_LogPrint(const Log_record* pRecord){
+	const char* pText = pRecord->Format;
+	char Conversion[OMAROS_LOG_CONVERSION_SIZE];
+	uint32 Length, Arg = 0;
+
+	printf("%8lu: ", (unsigned long)pRecord->Tick);
+	while(*pText != '\0'){
+		/* Text up to the next conversion */
+		for(Length = 0; (pText[Length] != '\0') && (pText[Length] != '%'); Length++);
+		printf("%.*s", (int)Length, pText);
+		pText += Length;
+		if(*pText == '\0'){
+			break;
+		}
+
+		/* The conversion with its flags, width and precision */
+		Length = 1 + strspn(pText + 1, "-+ #0123456789.");
+		if(pText[Length] != '\0'){
+			Length++;
+		}
+		if(Length >= sizeof(Conversion)){
+			Length = sizeof(Conversion) - 1;
+		}
+		memcpy(Conversion, pText, Length);
+		Conversion[Length] = '\0';
+		pText += Length;
+
+		/* Each argument is passed to printf with the type its conversion reads */
+		if(Conversion[Length - 1] == '%'){
+			printf("%%");
+		}
+		else if((Arg >= pRecord->NoOfArgs) || (strchr("diuxXcps", Conversion[Length - 1]) == NULL)){
+			printf("%s", Conversion);
+		}
+		else if(Conversion[Length - 1] == 's'){
+			printf(Conversion, (const char*)pRecord->Args[Arg++]);
+		}
+		else if(Conversion[Length - 1] == 'p'){
+			printf(Conversion, (void*)pRecord->Args[Arg++]);
+		}
+		else{
+			printf(Conversion, (unsigned int)pRecord->Args[Arg++]);
+		}
+	}
+	printf("\n");
+}
+
+/**=============================================
+ * @Fn			- OmarOS_LogGetStats
+ * @brief 		- Reports how many records were read and dropped, and the buffer high water mark
+ * @param [out] - pStats: Pointer to the structure to be filled
+ * @retval 		- None
+ * Note			- None
+ */
+void OmarOS_LogGetStats(Log_stats* pStats){
+	pStats->Read = Log_Control.NoOfRead;
+	pStats->Dropped = Log_Control.Dropped;
+#if (OMAROS_USE_STATS == 1)
+	pStats->MaxUsed = Log_Control.MaxUsed * sizeof(uint32);
+#else
+	pStats->MaxUsed = 0;
+#endif
+}
+
+#if (OMAROS_LOG_TASK == 1)
+/* Prints everything logged since the last pass, then sleeps */
+static void OmarOS_LogService(void){
+	Log_record Record;
+	uint32 Dropped = 0;
+
+	while(1){
+		while(OmarOS_LogRead(&Record)){
+			OmarOS_LogPrint(&Record);
+		}
+		if(Log_Control.Dropped != Dropped){
+			Dropped = Log_Control.Dropped;
+			printf("log: %lu records dropped\n", (unsigned long)Dropped);
+		}
+		OmarOS_TaskWait(OMAROS_LOG_FLUSH_PERIOD, &Log_Control.ServiceTask);
+	}
+}
+#endif
+
+/**=============================================
+ * @Fn			- OmarOS_LogInit
+ * @brief 		- Empties the log buffer and creates the log task
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- Called by OmarOS_Init
+ */
+OmarOS_errorTypes OmarOS_LogInit(void){
+	uint32 index;
+
+	for(index = 0; index < OMAROS_LOG_BUFFER_WORDS; index++){
+		Log_Control.Buffer[index] = 0;
+	}
+	Log_Control.Write = 0;
+	Log_Control.Read = 0;
+	Log_Control.Dropped = 0;
+	Log_Control.NoOfRead = 0;
+#if (OMAROS_USE_STATS == 1)
+	Log_Control.MaxUsed = 0;
+#endif
+
+#if (OMAROS_LOG_TASK == 1)
+	Log_Control.ServiceTask.pConfig = &LOG_TASK_CONFIG;
+	return OmarOS_CreateTask(&Log_Control.ServiceTask);
+#else
+	return noError;
+#endif
+}
+
+#endif
@@ -0,0 +1,180 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_MemPool.c 			                         */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+#include "OmarOS_MemPool.h"
+
+#if (MEMPOOL_LOCK_FREE == 1) && (OMAROS_USE_STATS == 1)
+/* Any exception entry/return clears the exclusive monitor, so a STREX only succeeds
+ * if nothing touched the pool since the LDREX (no ABA problem on the free list) */
+static uint32 MemPool_AtomicAdd(volatile uint32* pValue, uint32 Delta){
+	uint32 NewValue;
+	do{
+		NewValue = __LDREXW((volatile uint32_t*)pValue) + Delta;
+	}while(__STREXW(NewValue, (volatile uint32_t*)pValue) != 0);
+	return NewValue;
+}
+
+static void MemPool_AtomicMax(volatile uint32* pValue, uint32 Value){
+	do{
+		if(__LDREXW((volatile uint32_t*)pValue) >= Value){
+			__CLREX();
+			break;
+		}
+	}while(__STREXW(Value, (volatile uint32_t*)pValue) != 0);
+}
+#endif
+
+/**=============================================
+ * @Fn			- OmarOS_MemPoolInit
+ * @brief 		- Splits a buffer into fixed size blocks and links them in the pool's free list
+ * @param [in] 	- pPool: Pointer to the pool object
+ * @param [in] 	- pBuffer: Word aligned buffer, declare it with MEMPOOL_BUFFER
+ * @param [in] 	- BlockSize: Size of one block in bytes
+ * @param [in] 	- NoOfBlocks: Number of blocks in the buffer
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- Must be called before the pool is used by any task or ISR
+ */
+OmarOS_errorTypes OmarOS_MemPoolInit(MemPool_ref* pPool, void* pBuffer, uint32 BlockSize, uint32 NoOfBlocks){
+	uint32 index;
+	MemPool_Block* pBlock;
+
+	if((pPool == NULL) || (pBuffer == NULL) || (NoOfBlocks == 0) || ((uint32)pBuffer & (sizeof(uint32) - 1))){
+		return MemPoolInvalidConfig;
+	}
+
+	/* Every free block must be able to hold the free list link */
+	if(BlockSize < sizeof(MemPool_Block)){
+		BlockSize = sizeof(MemPool_Block);
+	}
+	BlockSize = MEMPOOL_BLOCK_WORDS(BlockSize) * sizeof(uint32);
+
+	pPool->pBuffer = (uint8*)pBuffer;
+	pPool->BlockSize = BlockSize;
+	pPool->NoOfBlocks = NoOfBlocks;
+#if (OMAROS_USE_STATS == 1)
+	pPool->UsedBlocks = 0;
+	pPool->HighWaterMark = 0;
+	pPool->FailedAllocations = 0;
+#endif
+
+	/* Link all blocks in address order */
+	for(index = 0; index < (NoOfBlocks - 1); index++){
+		pBlock = (MemPool_Block*)(pPool->pBuffer + (index * BlockSize));
+		pBlock->pNext = (MemPool_Block*)((uint8*)pBlock + BlockSize);
+	}
+	pBlock = (MemPool_Block*)(pPool->pBuffer + ((NoOfBlocks - 1) * BlockSize));
+	pBlock->pNext = NULL;
+
+	pPool->pFreeList = (MemPool_Block*)pPool->pBuffer;
+
+	return noError;
+}
+
+/**=============================================
+ * @Fn			- OmarOS_MemPoolAlloc
+ * @brief 		- Takes one block from the pool in constant time
+ * @param [in] 	- pPool: Pointer to the pool object
+ * @retval 		- Pointer to the allocated block or NULL if the pool is empty
+ * Note			- Can be called from tasks and ISRs with MEMPOOL_LOCK_FREE 1, with 0 only from ISRs and
+ * 				  before OmarOS_StartOS (PRIMASK can't be set by an unprivileged task)
+ */
+void* OmarOS_MemPoolAlloc(MemPool_ref* pPool){
+	MemPool_Block* pBlock;
+
+#if (MEMPOOL_LOCK_FREE == 1)
+	/* Pop the free list head */
+	do{
+		pBlock = (MemPool_Block*)__LDREXW((volatile uint32_t*)&pPool->pFreeList);
+		if(pBlock == NULL){
+			__CLREX();
+			break;
+		}
+	}while(__STREXW((uint32_t)pBlock->pNext, (volatile uint32_t*)&pPool->pFreeList) != 0);
+
+#if (OMAROS_USE_STATS == 1)
+	if(pBlock != NULL){
+		MemPool_AtomicMax(&pPool->HighWaterMark, MemPool_AtomicAdd(&pPool->UsedBlocks, 1));
+	}
+	else{
+		MemPool_AtomicAdd(&pPool->FailedAllocations, 1);
+	}
+#endif
+#else
+	uint32 primask = __get_PRIMASK();
+	__disable_irq();
+
+	pBlock = pPool->pFreeList;
+	if(pBlock != NULL){
+		pPool->pFreeList = pBlock->pNext;
+#if (OMAROS_USE_STATS == 1)
+		pPool->UsedBlocks++;
+		if(pPool->UsedBlocks > pPool->HighWaterMark){
+			pPool->HighWaterMark = pPool->UsedBlocks;
+		}
+#endif
+	}
+#if (OMAROS_USE_STATS == 1)
+	else{
+		pPool->FailedAllocations++;
+	}
+#endif
+
+	__set_PRIMASK(primask);
+#endif
+
+	return pBlock;
+}
+
+/**=============================================
+ * @Fn			- OmarOS_MemPoolFree
+ * @brief 		- Returns a block to its pool in constant time
+ * @param [in] 	- pPool: Pointer to the pool object
+ * @param [in] 	- pBlock: Pointer returned by OmarOS_MemPoolAlloc
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- Can be called from tasks and ISRs with MEMPOOL_LOCK_FREE 1, with 0 only from ISRs and
+ * 				  before OmarOS_StartOS (PRIMASK can't be set by an unprivileged task).
+ * 				  Freeing the same block twice is not detected
+ */
+OmarOS_errorTypes OmarOS_MemPoolFree(MemPool_ref* pPool, void* pBlock){
+	MemPool_Block* pFreeBlock = (MemPool_Block*)pBlock;
+	uint32 offset;
+
+	/* The block must be inside this pool and on a block boundary */
+	if((uint8*)pBlock < pPool->pBuffer){
+		return MemPoolInvalidBlock;
+	}
+	offset = (uint32)((uint8*)pBlock - pPool->pBuffer);
+	if((offset >= (pPool->BlockSize * pPool->NoOfBlocks)) || ((offset % pPool->BlockSize) != 0)){
+		return MemPoolInvalidBlock;
+	}
+
+#if (MEMPOOL_LOCK_FREE == 1)
+	/* Push the block on the free list head */
+	do{
+		pFreeBlock->pNext = (MemPool_Block*)__LDREXW((volatile uint32_t*)&pPool->pFreeList);
+	}while(__STREXW((uint32_t)pFreeBlock, (volatile uint32_t*)&pPool->pFreeList) != 0);
+
+#if (OMAROS_USE_STATS == 1)
+	MemPool_AtomicAdd(&pPool->UsedBlocks, (uint32)-1);
+#endif
+#else
+	uint32 primask = __get_PRIMASK();
+	__disable_irq();
+
+	pFreeBlock->pNext = pPool->pFreeList;
+	pPool->pFreeList = pFreeBlock;
+#if (OMAROS_USE_STATS == 1)
+	pPool->UsedBlocks--;
+#endif
+
+	__set_PRIMASK(primask);
+#endif
+
+	return noError;
+}
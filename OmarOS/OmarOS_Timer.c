@@ -0,0 +1,162 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_Timer.c 			                             */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+#include "OmarOS_Timer.h"
+
+#if (OMAROS_USE_TIMERS == 1)
+
+static void OmarOS_TimerService(void);
+static void OmarOS_TimerInsert(Timer_ref* pTimer);
+static void OmarOS_TimerRemove(Timer_ref* pTimer);
+
+static const Task_Config TIMER_TASK_CONFIG = {
+	OMAROS_TASK_NAME("timertask"),
+	.pf_TaskEntry = OmarOS_TimerService,
+	.Stack_Size = OMAROS_TIMER_STACK_SIZE,
+	.Priority = OMAROS_TIMER_TASK_PRIORITY,
+	.AutoStart = Autostart_Disabled
+};
+
+struct{
+	Timer_ref* volatile pActiveList; /* Sorted by expiry tick, read by SysTick */
+	Task_ref ServiceTask;
+}Timer_Control = { .ServiceTask = { .pConfig = &TIMER_TASK_CONFIG } };
+
+/* Called with the scheduler suspended, the list head is switched with a single store */
+static void OmarOS_TimerInsert(Timer_ref* pTimer){
+	Timer_ref* volatile* ppTimer = &Timer_Control.pActiveList;
+
+	/* Timers with the same expiry run in the order they were started */
+	while((*ppTimer != NULL) && OMAROS_TICK_REACHED(pTimer->ExpiryTick, (*ppTimer)->ExpiryTick)){
+		ppTimer = &((*ppTimer)->pNext);
+	}
+	pTimer->pNext = *ppTimer;
+	*ppTimer = pTimer;
+	pTimer->Active = 1;
+}
+
+/* Called with the scheduler suspended */
+static void OmarOS_TimerRemove(Timer_ref* pTimer){
+	Timer_ref* volatile* ppTimer = &Timer_Control.pActiveList;
+
+	while((*ppTimer != NULL) && (*ppTimer != pTimer)){
+		ppTimer = &((*ppTimer)->pNext);
+	}
+	if(*ppTimer != NULL){
+		*ppTimer = pTimer->pNext;
+	}
+	pTimer->Active = 0;
+}
+
+/* Runs every due callback, then sleeps until SysTick finds the next timer due */
+static void OmarOS_TimerService(void){
+	Timer_ref* pTimer;
+	uint32 Now;
+
+	while(1){
+		while(1){
+			OmarOS_SuspendScheduler();
+			Now = OmarOS_GetTickCount();
+			pTimer = Timer_Control.pActiveList;
+			if((pTimer == NULL) || !OMAROS_TICK_REACHED(Now, pTimer->ExpiryTick)){
+				OmarOS_ResumeScheduler();
+				break;
+			}
+
+			/* Requeue auto-reload timers before the callback so it can stop or restart them */
+			Timer_Control.pActiveList = pTimer->pNext;
+			if(pTimer->Period != 0){
+				pTimer->ExpiryTick += pTimer->Period;
+				if(OMAROS_TICK_REACHED(Now, pTimer->ExpiryTick)){
+					/* Expiries missed while the service was delayed are dropped */
+					pTimer->ExpiryTick = Now + pTimer->Period;
+				}
+				OmarOS_TimerInsert(pTimer);
+			}
+			else{
+				pTimer->Active = 0;
+			}
+			OmarOS_ResumeScheduler();
+
+			pTimer->pf_Callback(pTimer);
+		}
+
+		OmarOS_TerminateTask(&Timer_Control.ServiceTask);
+	}
+}
+
+/**=============================================
+ * @Fn			- OmarOS_TimerInit
+ * @brief 		- Creates the timer service task
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- Called by OmarOS_Init
+ */
+OmarOS_errorTypes OmarOS_TimerInit(void){
+	Timer_Control.pActiveList = NULL;
+	return OmarOS_CreateTask(&Timer_Control.ServiceTask);
+}
+
+/**=============================================
+ * @Fn			- OmarOS_TimerTick
+ * @brief 		- Activates the timer service task when the earliest timer is due
+ * @param [in] 	- Now: Current tick count
+ * @retval 		- None
+ * Note			- Called by SysTick_Handler, constant time
+ */
+void OmarOS_TimerTick(uint32 Now){
+	Timer_ref* pHead = Timer_Control.pActiveList;
+
+	/* A service that is still finishing its last batch is caught on a later tick */
+	if((pHead != NULL) && OMAROS_TICK_REACHED(Now, pHead->ExpiryTick) && (Timer_Control.ServiceTask.TaskState == Suspended)){
+		OmarOS_ActivateTask(&Timer_Control.ServiceTask);
+	}
+}
+
+/**=============================================
+ * @Fn			- OmarOS_TimerStart
+ * @brief 		- Starts (or restarts) a one-shot or auto-reload timer
+ * @param [in] 	- pTimer: Pointer to the timer, pf_Callback must be set
+ * @param [in] 	- Delay: Ticks before the first expiry
+ * @param [in] 	- Period: Ticks between later expiries, 0 for a one-shot timer
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- Can be called from tasks and from timer callbacks, not from ISRs
+ */
+OmarOS_errorTypes OmarOS_TimerStart(Timer_ref* pTimer, uint32 Delay, uint32 Period){
+	if((pTimer == NULL) || (pTimer->pf_Callback == NULL)){
+		return TimerInvalidConfig;
+	}
+
+	OmarOS_SuspendScheduler();
+	if(pTimer->Active){
+		OmarOS_TimerRemove(pTimer);
+	}
+	pTimer->Period = Period;
+	pTimer->ExpiryTick = OmarOS_GetTickCount() + Delay;
+	OmarOS_TimerInsert(pTimer);
+	OmarOS_ResumeScheduler();
+
+	return noError;
+}
+
+/**=============================================
+ * @Fn			- OmarOS_TimerStop
+ * @brief 		- Stops a timer, its callback won't run until it is started again
+ * @param [in] 	- pTimer: Pointer to the timer
+ * @retval 		- None
+ * Note			- Can be called from tasks and from timer callbacks, not from ISRs
+ */
+void OmarOS_TimerStop(Timer_ref* pTimer){
+	OmarOS_SuspendScheduler();
+	if(pTimer->Active){
+		OmarOS_TimerRemove(pTimer);
+	}
+	OmarOS_ResumeScheduler();
+}
+
+#endif
@@ -9,17 +9,49 @@
 
 #include "scheduler.h"
 #include "OmarOS_FIFO.h"
-
+#if (OMAROS_USE_TIMERS == 1)
+#include "OmarOS_Timer.h"
+#endif
+#if (OMAROS_USE_LOG == 1)
+#include "OmarOS_Log.h"
+#endif
+#if (OMAROS_USE_CONSOLE == 1)
+#include "OmarOS_Console.h"
+#endif
+#if (HEAP_TASK_QUOTAS == 1)
+#include "OmarOS_Heap.h"
+#endif
+
+#if (OMAROS_USE_TRACE == 1)
 uint8 IdleTaskLED, SysTickLED;
+#endif
 
 struct{
 	Task_ref *OS_Tasks[MAX_NO_TASKS]; /* Scheduling Table */
-	uint8  NoOfActiveTasks;
+	OmarOS_TaskIndex NoOfActiveTasks;
 	uint32 _S_MSP_OS;
 	uint32 _E_MSP_OS;
 	uint32 PSP_Task_Locator;
 	Task_ref *CurrentTask;
 	Task_ref *NextTask;
+	volatile uint32 TickCount;   /* Low word of the 64 bits tick count */
+	volatile uint32 TickCountHi;
+	volatile uint32 SchedulerLockCount;
+	volatile uint8  SwitchPending;
+#if (OMAROS_USE_STATS == 1)
+	Scheduler_stats Stats;
+#endif
+#if (OMAROS_USE_RUNTIME_STATS == 1)
+	uint64 LastSwitchTime; /* Timestamp the current task was switched in */
+#endif
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+	uint32 DeadlineMisses;
+	uint32 BackgroundOrder; /* Last turn given to a task without a deadline */
+#endif
+	struct OS_StackRegion *FreeStacks; /* Released task stacks, sorted by address */
+#if (OMAROS_USE_MUTEX == 1)
+	Mutex_ref *MutexList; /* Mutexes added by OmarOS_RegisterMutex */
+#endif
 	enum{
 		OS_Suspended,
 		OS_Running,
@@ -27,22 +59,95 @@ struct{
 	}OS_ModeID;
 }OS_Control;
 
+/* Services without arguments, requested through OmarOS_Set_SVC */
 typedef enum{
 	SVC_ActivateTask,
 	SVC_TerminateTask,
 	SVC_TaskWaitingTime
 }SVC_ID;
 
+/* Services that pass values in r0/r1, their callers issue the svc instruction themselves */
+typedef enum{
+	SVC_DeleteTask = SVC_TaskWaitingTime + 1,
+	SVC_GetTimestamp,
+	SVC_AdmitTask
+}SVC_ArgsID;
+
+/* Header written at the bottom of every released stack region */
+typedef struct OS_StackRegion{
+	struct OS_StackRegion *pNext;
+	uint32 Size;
+}OS_StackRegion;
+
+/* Every stack region is the task stack followed by an 8 bytes gap */
+#define STACK_GAP_SIZE		8
+#define STACK_ALIGN_UP(x)	(((x) + 7UL) & ~7UL)
+
+/* Priorities go from 0 to OMAROS_IDLE_PRIORITY */
+#if (OMAROS_PRIORITY_LEVELS < 256)
+#define PRIORITY_IS_VALID(x)	((x) <= OMAROS_IDLE_PRIORITY)
+#else
+/* Every uint8 value is a priority, comparing would always be true */
+#define PRIORITY_IS_VALID(x)	(1)
+#endif
+
+/* Ready Queue FIFO (Task_ref*), declared in scheduler.h */
+FIFO_DEFINE(FIFO, Task_ref*)
+
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_FIXED_PRIORITY)
 FIFO_Buf_t Ready_QUEUE;
-Task_ref *Ready_QUEUE_FIFO[MAX_NO_TASKS];
-static Task_ref IDLE_TASK;
-
+Task_ref *Ready_QUEUE_FIFO[READY_QUEUE_SIZE];
+#else
+/* Ready tasks as a binary min-heap on the absolute deadline, the next task is EDF_Heap[0] */
+static Task_ref *EDF_Heap[MAX_NO_TASKS];
+static OmarOS_TaskIndex EDF_HeapSize;
+#endif
+/* Deleted tasks whose stack can't be released from the SVC handler */
+FIFO_Buf_t Deleted_QUEUE;
+Task_ref *Deleted_QUEUE_FIFO[DELETED_QUEUE_SIZE];
 static void OmarOS_IdleTask(void);
+static const Task_Config IDLE_TASK_CONFIG = {
+	OMAROS_TASK_NAME("idletask"),
+	.pf_TaskEntry = OmarOS_IdleTask,
+	.Stack_Size = OMAROS_IDLE_STACK_SIZE,
+	.Priority = OMAROS_IDLE_PRIORITY,
+	.AutoStart = Autostart_Disabled,
+	.TimeSlice = 1 /* Tasks woken while idle runs are only scheduled by SysTick */
+};
+static Task_ref IDLE_TASK = { .pConfig = &IDLE_TASK_CONFIG };
+
 static void OmarOS_Create_TaskStack(Task_ref* newTask);
 static void OmarOS_UpdateSchedulerTable(void);
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_FIXED_PRIORITY)
 static void OmarOS_BubbleSort(void);
+#else
+static uint8 OmarOS_EDF_Rank(const Task_ref* pTask);
+static uint8 OmarOS_EDF_Earlier(const Task_ref* pA, const Task_ref* pB);
+static void OmarOS_EDF_Background(Task_ref* pTask);
+static void OmarOS_EDF_Push(Task_ref* pTask);
+static void OmarOS_EDF_JobFinished(Task_ref* pTask);
+#endif
 static void OmarOS_DecideNextTask(void);
+static void OmarOS_Reschedule(void);
+static void OmarOS_ReloadTimeSlice(Task_ref* pTask);
+static void OmarOS_SwitchContext(void);
+#if (OMAROS_USE_RUNTIME_STATS == 1)
+static void OmarOS_AccountRunTime(void);
+#endif
 static void OmarOS_Update_TasksWaitingTime(void);
+static OmarOS_errorTypes OmarOS_RemoveTask(Task_ref* pTask);
+static OmarOS_errorTypes OmarOS_AddTask(Task_ref* newTask);
+#if (OMAROS_USE_ADMISSION_CONTROL == 1)
+static OmarOS_errorTypes OmarOS_AdmitTask(Task_ref* pTask);
+static void OmarOS_Update_TaskBudgets(void);
+#if (OMAROS_BUDGET_OVERRUN_ACTION == OMAROS_BUDGET_DEMOTE)
+static void OmarOS_SetBasePriority(Task_ref* pTask, uint8 OldBase, uint8 NewBase);
+#endif
+#endif
+static uint8 OmarOS_AllocateTaskStack(Task_ref* newTask, uint32 Stack_Size);
+static void OmarOS_ReleaseTaskStack(Task_ref* pTask);
+static void OmarOS_ReclaimDeletedStacks(void);
+static uint64 OmarOS_ReadTimestamp(void);
 
 void OmarOS_Set_SVC (SVC_ID ID){
 	switch(ID){
@@ -58,14 +163,58 @@ void OmarOS_Set_SVC (SVC_ID ID){
 	}
 }
 
+/* Pends PendSV only if DecideNextTask picked another task */
+static void OmarOS_SwitchContext(void){
+	if(OS_Control.NextTask != OS_Control.CurrentTask){
+#if (OMAROS_USE_STATS == 1)
+		OS_Control.Stats.ContextSwitches++;
+#endif
+#if (OMAROS_USE_RUNTIME_STATS == 1)
+		OmarOS_AccountRunTime();
+#endif
+		Trigger_OS_PendSV();
+	}
+	else{
+#if (OMAROS_USE_STATS == 1)
+		OS_Control.Stats.AvoidedSwitches++;
+#endif
+	}
+}
+
+#if (OMAROS_USE_RUNTIME_STATS == 1)
+/* Charges the time since the last switch to the task being switched out */
+static void OmarOS_AccountRunTime(void){
+	Task_ref* pTask = OS_Control.CurrentTask;
+	uint64 Now = OmarOS_ReadTimestamp();
+	uint32 Elapsed = (uint32)(Now - OS_Control.LastSwitchTime);
+
+	OS_Control.LastSwitchTime = Now;
+	pTask->Stats.RunTime += Elapsed;
+	pTask->Stats.JobTime += Elapsed;
+
+	if(pTask->Stats.JobEnded){
+		pTask->Stats.JobEnded = 0;
+		pTask->Stats.Jobs++;
+		if(pTask->Stats.JobTime > pTask->Stats.MaxJobTime){
+			pTask->Stats.MaxJobTime = pTask->Stats.JobTime;
+		}
+		pTask->Stats.JobTime = 0;
+	}
+}
+#endif
+
+/* Starts a new quantum for the task about to run */
+static void OmarOS_ReloadTimeSlice(Task_ref* pTask){
+	pTask->SliceRemaining = (pTask->pConfig->TimeSlice != 0) ? pTask->pConfig->TimeSlice : OMAROS_DEFAULT_TIME_SLICE;
+}
+
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_FIXED_PRIORITY)
 static void OmarOS_DecideNextTask(void){
 	/* If Ready Queue is empty && OS_Control->CurrentTask != Suspended */
-	if(Ready_QUEUE.counter == 0 && OS_Control.CurrentTask->TaskState != Suspended){
-	OS_Control.CurrentTask->TaskState = Running;
-
-	/* Add the current task again (Round Robin) */
-	FIFO_enqueue(&Ready_QUEUE, OS_Control.CurrentTask);
-	OS_Control.NextTask = OS_Control.CurrentTask;
+	if(FIFO_count(&Ready_QUEUE) == 0 && OS_Control.CurrentTask->TaskState != Suspended){
+		/* Nothing else is ready, keep the current task without cycling it through the queue */
+		OS_Control.CurrentTask->TaskState = Running;
+		OS_Control.NextTask = OS_Control.CurrentTask;
 	}
 	else{
 		FIFO_dequeue(&Ready_QUEUE, &OS_Control.NextTask);
@@ -77,31 +226,89 @@ static void OmarOS_DecideNextTask(void){
 			OS_Control.CurrentTask->TaskState = Ready;
 		}
 	}
+
+	OmarOS_ReloadTimeSlice(OS_Control.NextTask);
+}
+#else
+static void OmarOS_DecideNextTask(void){
+	/* A task that suspended itself but didn't reach its SVC yet is still in the heap */
+	if(EDF_Heap[0]->TaskState == Suspended){
+		OmarOS_UpdateSchedulerTable();
+	}
+
+	/* Keep the current task on equal deadlines to save a switch */
+	if((OS_Control.CurrentTask->TaskState != Suspended) && !OmarOS_EDF_Earlier(EDF_Heap[0], OS_Control.CurrentTask)){
+		OS_Control.NextTask = OS_Control.CurrentTask;
+	}
+	else{
+		if(OS_Control.CurrentTask->TaskState == Running){
+			OS_Control.CurrentTask->TaskState = Ready;
+		}
+		OS_Control.NextTask = EDF_Heap[0];
+	}
+	OS_Control.NextTask->TaskState = Running;
+
+	OmarOS_ReloadTimeSlice(OS_Control.NextTask);
 }
+#endif
 
 /* Used to execute specific OS Services */
 void OmarOS_SVC_services (uint32 *StackFramePointer){
 	/* OS_SVC_Set Stack -> r0 -> argument0 = StackFramePointer
 	   OS_SVC_Set : r0,r1,r2,r3,r12,LR,PC,xPSR */
 	uint8 SVC_number;
+	uint64 Timestamp;
+#if (OMAROS_USE_ADMISSION_CONTROL == 1)
+	Task_ref* pTask;
+#endif
 	SVC_number = *((uint8*)((uint8*)(StackFramePointer[6])) - 2);
 	switch(SVC_number){
+	case SVC_GetTimestamp:
+		/* Returned to the caller in the stacked r0/r1 */
+		Timestamp = OmarOS_ReadTimestamp();
+		StackFramePointer[0] = (uint32)Timestamp;
+		StackFramePointer[1] = (uint32)(Timestamp >> 32);
+		break;
+#if (OMAROS_USE_ADMISSION_CONTROL == 1)
+	case SVC_AdmitTask:
+		/* Activate the task (stacked r0) if it fits under the utilization bound, the result goes back in r0 */
+		pTask = (Task_ref*)StackFramePointer[0];
+		StackFramePointer[0] = OmarOS_AdmitTask(pTask);
+		if(StackFramePointer[0] == noError){
+			pTask->TaskState = Waiting;
+			OmarOS_Reschedule();
+		}
+		break;
+#endif
+	case SVC_DeleteTask:
+		/* Remove the task (stacked r0) from the Scheduling Table then reschedule, the result goes back in r0 */
+		StackFramePointer[0] = OmarOS_RemoveTask((Task_ref*)StackFramePointer[0]);
+		/* fall through */
 	case SVC_ActivateTask:
 	case SVC_TerminateTask:
 	case SVC_TaskWaitingTime:
-		/* Update Scheduler Table and Ready Queue */
-		OmarOS_UpdateSchedulerTable();
+		OmarOS_Reschedule();
+		break;
+	}
+}
 
-		/* If OS is in running state -> Decide what next task */
-		if(OS_Control.OS_ModeID == OS_Running){
-			if(STRING_compare_caseSensitive((uint8*)OS_Control.CurrentTask->TaskName, (uint8*)"idletask") != 0){
-				OmarOS_DecideNextTask();
+/* Runs in the SVC handler after a task changed its state */
+static void OmarOS_Reschedule(void){
+	/* Update Scheduler Table and Ready Queue */
+	OmarOS_UpdateSchedulerTable();
 
-				/* Switch/Restore Context */
-				Trigger_OS_PendSV();
-			}
+	/* If OS is in running state -> Decide what next task */
+	if(OS_Control.OS_ModeID == OS_Running){
+		if(OS_Control.SchedulerLockCount != 0){
+			/* Scheduler is suspended, switch once it is resumed */
+			OS_Control.SwitchPending = 1;
+		}
+		else if(OS_Control.CurrentTask != &IDLE_TASK){
+			OmarOS_DecideNextTask();
+
+			/* Switch/Restore Context */
+			OmarOS_SwitchContext();
 		}
-		break;
 	}
 }
 
@@ -131,6 +338,10 @@ __attribute ((naked)) void PendSV_Handler(void){
 	/* Restore context of next task */
 	OS_Control.CurrentTask = OS_Control.NextTask;
 	OS_Control.NextTask = NULL;
+#if (OMAROS_USE_REENT == 1)
+	/* Before R4 to R11 are loaded, the compiler may use them here */
+	_impure_ptr = &OS_Control.CurrentTask->Reent;
+#endif
 
 	__asm volatile ("mov r11, %0" : : "r" (*(OS_Control.CurrentTask->Current_PSP)));
 	OS_Control.CurrentTask->Current_PSP++;
@@ -156,21 +367,63 @@ __attribute ((naked)) void PendSV_Handler(void){
 }
 
 void SysTick_Handler(void){
+#if (OMAROS_USE_TRACE == 1)
 	SysTickLED ^= 1;
+#endif
+	/* Both words change together for readers preempting this handler */
+	__disable_irq();
+	OS_Control.TickCount++;
+	if(OS_Control.TickCount == 0){
+		OS_Control.TickCountHi++;
+	}
+	__enable_irq();
 
+#if (OMAROS_USE_ADMISSION_CONTROL == 1)
+	OmarOS_Update_TaskBudgets();
+#endif
 	OmarOS_Update_TasksWaitingTime();
+#if (OMAROS_USE_TIMERS == 1)
+	OmarOS_TimerTick(OS_Control.TickCount);
+#endif
+
+	/* A task woken above already picked the next task through its SVC and pended the switch,
+	 * deciding again would take that task out of the Ready Queue and keep the current one */
+	if((OS_Control.NextTask != NULL) && (OS_Control.NextTask != OS_Control.CurrentTask)){
+		return;
+	}
+
+	/* Round robin only rotates once the running task used its whole quantum (idle's quantum is 1 tick) */
+	if(OS_Control.CurrentTask->SliceRemaining > 1){
+		OS_Control.CurrentTask->SliceRemaining--;
+		return;
+	}
+
+	if(OS_Control.SchedulerLockCount != 0){
+		/* Scheduler is suspended, switch once it is resumed */
+		OS_Control.SwitchPending = 1;
+		return;
+	}
+
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+	/* A background task that used its quantum lets the next background task run */
+	if(OmarOS_EDF_Rank(OS_Control.CurrentTask) == 1){
+		OmarOS_EDF_Background(OS_Control.CurrentTask);
+		OmarOS_UpdateSchedulerTable();
+	}
+#endif
 
 	/* Determine Current and Next tasks */
 	OmarOS_DecideNextTask();
 
 	/* Switch context and restore */
-	Trigger_OS_PendSV();
+	OmarOS_SwitchContext();
 }
 
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_FIXED_PRIORITY)
 static void OmarOS_UpdateSchedulerTable(void){
 	Task_ref *temp = NULL;
 	Task_ref *pTask, *pNextTask;
-	uint8 i = 0;
+	OmarOS_TaskIndex i = 0;
 
 	/* Bubble sort Scheduler Table */
 	OmarOS_BubbleSort();
@@ -181,11 +434,11 @@ static void OmarOS_UpdateSchedulerTable(void){
 	/* Update Ready Queue */
 	while(i < OS_Control.NoOfActiveTasks){
 		pTask = OS_Control.OS_Tasks[i];
-		pNextTask = OS_Control.OS_Tasks[i + 1];
+		pNextTask = ((i + 1) < OS_Control.NoOfActiveTasks) ? OS_Control.OS_Tasks[i + 1] : NULL;
 
 		if(pTask->TaskState != Suspended){
 			/* In case we reached to the end of available OSTasks */
-			if(pNextTask->TaskState == Suspended){
+			if((pNextTask == NULL) || (pNextTask->TaskState == Suspended)){
 				FIFO_enqueue(&Ready_QUEUE, pTask);
 				pTask->TaskState = Ready;
 				break;
@@ -215,7 +468,7 @@ static void OmarOS_UpdateSchedulerTable(void){
 }
 
 static void OmarOS_BubbleSort(void){
-	uint8 i, j, n;
+	OmarOS_TaskIndex i, j, n;
 	Task_ref *temp;
 	n = OS_Control.NoOfActiveTasks;
 	for(i = 0; i < (n - 1); i++){
@@ -228,6 +481,86 @@ static void OmarOS_BubbleSort(void){
 		}
 	}
 }
+#else
+/* 0: task with a deadline, 1: background task (no deadline), 2: idle */
+static uint8 OmarOS_EDF_Rank(const Task_ref* pTask){
+	if(pTask == &IDLE_TASK){
+		return 2;
+	}
+#if (OMAROS_USE_ADMISSION_CONTROL == 1)
+	/* Tasks demoted for using their whole budget run with the tasks without a deadline */
+	if(pTask->Admission.Demoted){
+		return 1;
+	}
+#endif
+	return (pTask->pConfig->RelativeDeadline == 0) ? 1 : 0;
+}
+
+/* Idle runs last, then background tasks in turn, the others by absolute deadline (wrap safe) */
+static uint8 OmarOS_EDF_Earlier(const Task_ref* pA, const Task_ref* pB){
+	uint8 RankA = OmarOS_EDF_Rank(pA);
+	uint8 RankB = OmarOS_EDF_Rank(pB);
+
+	if(RankA != RankB){
+		return (RankA < RankB);
+	}
+	if(RankA == 1){
+		/* The background task whose turn is the oldest first */
+		return ((sint32)(pA->BackgroundOrder - pB->BackgroundOrder) < 0);
+	}
+	return (RankA == 0) && ((sint32)(pA->AbsDeadline - pB->AbsDeadline) < 0);
+}
+
+/* Puts a task behind the other background tasks, done when it is released, demoted or used its quantum */
+static void OmarOS_EDF_Background(Task_ref* pTask){
+	OS_Control.BackgroundOrder++;
+	pTask->BackgroundOrder = OS_Control.BackgroundOrder;
+}
+
+static void OmarOS_EDF_Push(Task_ref* pTask){
+	OmarOS_TaskIndex child = EDF_HeapSize, parent;
+
+	EDF_HeapSize++;
+	while(child > 0){
+		parent = (child - 1) / 2;
+		if(!OmarOS_EDF_Earlier(pTask, EDF_Heap[parent])){
+			break;
+		}
+		EDF_Heap[child] = EDF_Heap[parent];
+		child = parent;
+	}
+	EDF_Heap[child] = pTask;
+}
+
+/* Rebuilds the deadline heap from every task that isn't suspended */
+static void OmarOS_UpdateSchedulerTable(void){
+	OmarOS_TaskIndex index;
+	Task_ref *pTask;
+
+	EDF_HeapSize = 0;
+	for(index = 0; index < OS_Control.NoOfActiveTasks; index++){
+		pTask = OS_Control.OS_Tasks[index];
+		if(pTask->TaskState == Suspended){
+			continue;
+		}
+		if(pTask->TaskState == Waiting){
+			/* Released since the last update, its new job gets its deadline */
+			pTask->AbsDeadline = OS_Control.TickCount + pTask->pConfig->RelativeDeadline;
+			OmarOS_EDF_Background(pTask);
+		}
+		pTask->TaskState = Ready;
+		OmarOS_EDF_Push(pTask);
+	}
+}
+
+/* Called when a job ends (its task waits or terminates) */
+static void OmarOS_EDF_JobFinished(Task_ref* pTask){
+	if((pTask->pConfig->RelativeDeadline != 0) && !OMAROS_TICK_REACHED(pTask->AbsDeadline, OS_Control.TickCount)){
+		pTask->DeadlineMisses++;
+		OS_Control.DeadlineMisses++;
+	}
+}
+#endif
 
 void OmarOS_Create_MainStack(void){
 	OS_Control._S_MSP_OS = (uint32)&_estack;
@@ -250,26 +583,58 @@ OmarOS_errorTypes OmarOS_Init(void){
 	/* Specify the Main Stack for OS */
 	OmarOS_Create_MainStack();
 
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_FIXED_PRIORITY)
 	/* Create OS Ready Queue */
-	if(FIFO_init(&Ready_QUEUE, Ready_QUEUE_FIFO, MAX_NO_TASKS) != FIFO_NO_ERROR){
+	if(FIFO_init(&Ready_QUEUE, Ready_QUEUE_FIFO, READY_QUEUE_SIZE) != FIFO_NO_ERROR){
+		retval |= readyQueueInitError;
+	}
+#endif
+	if(FIFO_init(&Deleted_QUEUE, Deleted_QUEUE_FIFO, DELETED_QUEUE_SIZE) != FIFO_NO_ERROR){
 		retval |= readyQueueInitError;
 	}
 
-	/* Configure IDLE Task */
+	/* Create IDLE Task */
 	if(!retval){ /* No error */
-		STRING_copy((uint8*)"idletask", (uint8*)&(IDLE_TASK.TaskName));
-		IDLE_TASK.Priority = 255; // Max value for uint8 = highest priority
-		IDLE_TASK.pf_TaskEntry = OmarOS_IdleTask;
-		IDLE_TASK.Stack_Size = 300;
 		retval |= OmarOS_CreateTask(&IDLE_TASK);
 	}
 
+#if (OMAROS_USE_TIMERS == 1)
+	/* Create Timer Service Task */
+	if(!retval){ /* No error */
+		retval |= OmarOS_TimerInit();
+	}
+#endif
+
+#if (OMAROS_USE_LOG == 1)
+	/* Empty the log buffer and create the Log Task */
+	if(!retval){ /* No error */
+		retval |= OmarOS_LogInit();
+	}
+#endif
+
+#if (OMAROS_USE_CONSOLE == 1)
+	/* Empty the console buffer and create the Console Task */
+	if(!retval){ /* No error */
+		retval |= OmarOS_ConsoleInit();
+	}
+#endif
+
 	return retval;
 }
 
 static void OmarOS_IdleTask(){
 	while(1){
+#if (OMAROS_USE_TRACE == 1)
 		IdleTaskLED ^= 1;
+#endif
+#if (OMAROS_USE_REENT == 0)
+		/* Release the stacks of tasks that deleted themselves. With OMAROS_USE_REENT their C library
+		 * state has to be reclaimed too, which may block on a stream, so the next OmarOS_CreateTask
+		 * or OmarOS_DeleteTask does it instead */
+		if(FIFO_count(&Deleted_QUEUE) != 0){
+			OmarOS_ReclaimDeletedStacks();
+		}
+#endif
 		__asm ("wfe");
 	}
 }
@@ -283,34 +648,270 @@ static void OmarOS_IdleTask(){
  */
 OmarOS_errorTypes OmarOS_CreateTask(Task_ref* newTask){
 	OmarOS_errorTypes retval = noError;
+	/* Keep every stack region 8 bytes aligned */
+	uint32 Stack_Size = STACK_ALIGN_UP(newTask->pConfig->Stack_Size);
+
+	/* Released stacks can be reused below */
+	OmarOS_ReclaimDeletedStacks();
+
+	OmarOS_SuspendScheduler();
+
+	if(!PRIORITY_IS_VALID(newTask->pConfig->Priority)){
+		retval = TaskInvalidPriority;
+	}
+#if (OMAROS_USE_ADMISSION_CONTROL == 1)
+	else if((newTask->pConfig->Budget != 0) && (newTask->pConfig->Budget > newTask->pConfig->Period)){
+		retval = TaskInvalidBudget;
+	}
+#endif
+	else if(OS_Control.NoOfActiveTasks >= MAX_NO_TASKS){
+		retval = MaxNoOfTasksReached;
+	}
+	else{
+		/* Reuse a released stack if one fits, or take a new one from the PSP Stack */
+		if(!OmarOS_AllocateTaskStack(newTask, Stack_Size)){
+			/* Task stack size exceeds the PSP Stack */
+			retval = taskExceededStackSize;
+		}
+	}
+
+	if(!retval){ /* No error */
+		retval = OmarOS_AddTask(newTask);
+	}
+
+	OmarOS_ResumeScheduler();
+
+	/* Tasks created while the OS is running are scheduled right away */
+	if((!retval) && (OS_Control.OS_ModeID == OS_Running) && (newTask->pConfig->AutoStart == Autostart_Enabled)){
+		retval = OmarOS_ActivateTask(newTask);
+	}
+
+	return retval;
+}
+
+/**=============================================
+ * @Fn			- OmarOS_RegisterStaticTasks
+ * @brief 		- Adds tasks whose stacks were laid out at build time to the Scheduling Table
+ * @param [in] 	- pTasks: Table of tasks generated by OMAROS_STATIC_TASKS_DEFINE
+ * @param [in] 	- NoOfTasks: Number of entries in the table
+ * @retval 		- Returns noError if no error happened or an error code if an error occured
+ * Note			- Should only be called after calling "OmarOS_Init" and before "OmarOS_StartOS"
+ */
+OmarOS_errorTypes OmarOS_RegisterStaticTasks(Task_ref* const pTasks[], uint32 NoOfTasks){
+	OmarOS_errorTypes retval = noError;
+	uint32 index;
+
+	if((OS_Control.NoOfActiveTasks + NoOfTasks) > MAX_NO_TASKS){
+		return MaxNoOfTasksReached;
+	}
 
-	/* Check if task stack size exceeds the PSP Stack */
-	newTask->_S_PSP_Task = OS_Control.PSP_Task_Locator;
-	newTask->_E_PSP_Task = newTask->_S_PSP_Task - newTask->Stack_Size;
-	if(newTask->_E_PSP_Task < (uint32)&_eheap){
-		return taskExceededStackSize;
+	/* A task that isn't admitted is still registered, only left suspended */
+	for(index = 0; index < NoOfTasks; index++){
+		if(OmarOS_AddTask(pTasks[index]) != noError){
+			retval = TaskAdmissionRejected;
+		}
 	}
 
+	return retval;
+}
+
+/* Builds the task initial frame and appends it to the Scheduling Table, the stack bounds must be set.
+ * Returns TaskAdmissionRejected if an auto started task doesn't fit under the utilization bound */
+static OmarOS_errorTypes OmarOS_AddTask(Task_ref* newTask){
+	OmarOS_errorTypes retval = noError;
+
 	/* Create the task stack area in PSP */
 	OmarOS_Create_TaskStack(newTask);
 
-	/* Allign 8Bytes spaces between Task PSP and new one */
-	if(!retval){ /* No error */
-		OS_Control.PSP_Task_Locator = newTask->_E_PSP_Task - 8;
+	/* Task State Update */
+	newTask->Priority = newTask->pConfig->Priority;
+	newTask->Block_State = disabled;
+#if (HEAP_TASK_QUOTAS == 1)
+	newTask->HeapUsed = 0;
+#endif
+#if (OMAROS_USE_REENT == 1)
+	_REENT_INIT_PTR(&newTask->Reent);
+#endif
+#if (OMAROS_USE_ADMISSION_CONTROL == 1)
+	newTask->Admission.Admitted = 0;
+	newTask->Admission.Demoted = 0;
+	newTask->Admission.Overruns = 0;
+	newTask->Admission.Utilization = (newTask->pConfig->Budget == 0) ? 0 :
+			(uint32)((((uint64)newTask->pConfig->Budget * 1000000UL) + newTask->pConfig->Period - 1) / newTask->pConfig->Period);
+#endif
+
+	/* Once the OS runs, tasks are only started by OmarOS_ActivateTask */
+	newTask->TaskState = Suspended;
+	if((newTask->pConfig->AutoStart == Autostart_Enabled) && (OS_Control.OS_ModeID != OS_Running)){
+		/* Released like OmarOS_ActivateTask does, the first Scheduler Table update gives its job a deadline */
+		newTask->TaskState = Waiting;
+#if (OMAROS_USE_ADMISSION_CONTROL == 1)
+		/* Auto started tasks go through admission like activated ones */
+		retval = OmarOS_AdmitTask(newTask);
+		if(retval != noError){
+			newTask->TaskState = Suspended;
+		}
+#endif
 	}
 
 	OS_Control.OS_Tasks[OS_Control.NoOfActiveTasks] = newTask;
 	OS_Control.NoOfActiveTasks++;
 
-	/* Task State Update */
-	if(newTask->AutoStart == Autostart_Enabled){
-		newTask->TaskState = Ready;
+	return retval;
+}
+
+/* Best fit over the released stacks, falls back to the PSP Stack bottom. Returns 0 if no space is left */
+static uint8 OmarOS_AllocateTaskStack(Task_ref* newTask, uint32 Stack_Size){
+	OS_StackRegion *pRegion, *pBest = NULL, **ppBest = NULL, **ppRegion;
+	uint32 RegionSize = Stack_Size + STACK_GAP_SIZE;
+
+	for(ppRegion = &OS_Control.FreeStacks; *ppRegion != NULL; ppRegion = &((*ppRegion)->pNext)){
+		pRegion = *ppRegion;
+		if((pRegion->Size >= RegionSize) && ((pBest == NULL) || (pRegion->Size < pBest->Size))){
+			pBest = pRegion;
+			ppBest = ppRegion;
+		}
+	}
+
+	if(pBest != NULL){
+		/* Take the top of the region, the rest stays released */
+		newTask->_S_PSP_Task = (uint32)pBest + pBest->Size;
+		if((pBest->Size - RegionSize) < sizeof(OS_StackRegion)){
+			/* Too small to be kept, the task gets the whole region */
+			*ppBest = pBest->pNext;
+			newTask->_E_PSP_Task = (uint32)pBest + STACK_GAP_SIZE;
+		}
+		else{
+			pBest->Size -= RegionSize;
+			newTask->_E_PSP_Task = newTask->_S_PSP_Task - Stack_Size;
+		}
+	}
+	else if((OS_Control.PSP_Task_Locator - Stack_Size) >= (uint32)&_eheap){
+		newTask->_S_PSP_Task = OS_Control.PSP_Task_Locator;
+		newTask->_E_PSP_Task = newTask->_S_PSP_Task - Stack_Size;
+		/* Allign 8Bytes spaces between Task PSP and new one */
+		OS_Control.PSP_Task_Locator = newTask->_E_PSP_Task - STACK_GAP_SIZE;
 	}
 	else{
-		newTask->TaskState = Suspended;
+		return 0;
 	}
 
-	return retval;
+	return 1;
+}
+
+/* Gives the task stack region back, merging it with its released neighbours */
+static void OmarOS_ReleaseTaskStack(Task_ref* pTask){
+	OS_StackRegion *pPrev = NULL, *pNext = OS_Control.FreeStacks, *pRegion;
+	uint32 Start = pTask->_E_PSP_Task - STACK_GAP_SIZE;
+	uint32 End = pTask->_S_PSP_Task;
+
+	/* Static task stacks are not part of the PSP Stack */
+	if(pTask->_E_PSP_Task < (uint32)&_eheap){
+		return;
+	}
+
+	/* Find the released regions below and above this one */
+	while((pNext != NULL) && ((uint32)pNext < Start)){
+		pPrev = pNext;
+		pNext = pNext->pNext;
+	}
+
+	/* Merge with the region above */
+	if((pNext != NULL) && ((uint32)pNext == End)){
+		End += pNext->Size;
+		pNext = pNext->pNext;
+	}
+
+	if(Start == OS_Control.PSP_Task_Locator){
+		/* Region is at the bottom of the used PSP Stack, give it back to the PSP Stack */
+		OS_Control.PSP_Task_Locator = End;
+		pRegion = pNext;
+	}
+	else if((pPrev != NULL) && (((uint32)pPrev + pPrev->Size) == Start)){
+		/* Merge with the region below */
+		pPrev->Size += End - Start;
+		pPrev->pNext = pNext;
+		return;
+	}
+	else{
+		pRegion = (OS_StackRegion*)Start;
+		pRegion->Size = End - Start;
+		pRegion->pNext = pNext;
+	}
+
+	if(pPrev != NULL){
+		pPrev->pNext = pRegion;
+	}
+	else{
+		OS_Control.FreeStacks = pRegion;
+	}
+}
+
+/* Releases the stacks of deleted tasks that were still in use when they got deleted */
+static void OmarOS_ReclaimDeletedStacks(void){
+	Task_ref* pTask;
+
+	OmarOS_SuspendScheduler();
+	while(FIFO_dequeue(&Deleted_QUEUE, &pTask) == FIFO_NO_ERROR){
+		OmarOS_ReleaseTaskStack(pTask);
+#if (HEAP_TASK_QUOTAS == 1)
+		/* Blocks it didn't free must not be charged to the next task using this Task_ref */
+		OmarOS_HeapReleaseOwner(pTask);
+#endif
+#if (OMAROS_USE_REENT == 1)
+		/* Closing its streams may flush output, block and free memory. This runs on the stack of the
+		 * task calling OmarOS_CreateTask or OmarOS_DeleteTask, so the scheduler is resumed for it
+		 * (it stays suspended if that task suspended it itself) */
+		OmarOS_ResumeScheduler();
+		_reclaim_reent(&pTask->Reent);
+		OmarOS_SuspendScheduler();
+#endif
+	}
+	OmarOS_ResumeScheduler();
+}
+
+/* Runs in the SVC handler, removes the task from the Scheduling Table. Returns TaskDeleteQueueFull,
+ * with the task left in the table, if its stack release has to wait and the Deleted Queue is full */
+static OmarOS_errorTypes OmarOS_RemoveTask(Task_ref* pTask){
+	uint32 index;
+	uint8 DelayRelease;
+
+	for(index = 0; (index < OS_Control.NoOfActiveTasks) && (OS_Control.OS_Tasks[index] != pTask); index++);
+	if((index == OS_Control.NoOfActiveTasks) || (pTask == &IDLE_TASK)){
+		return noError;
+	}
+
+#if (OMAROS_USE_REENT == 1)
+	/* The C library state can't be reclaimed in the SVC handler, the task always goes through the
+	 * queue and OmarOS_DeleteTask releases it once the SVC returned */
+	DelayRelease = 1;
+#else
+	/* A running task still uses its stack until the context switch, and a suspended
+	 * scheduler means a task may be walking the released stacks, so delay the release */
+	DelayRelease = (pTask == OS_Control.CurrentTask) || (OS_Control.SchedulerLockCount != 0);
+#endif
+	/* Checked before anything changes, a stack that can't be queued would never be released */
+	if(DelayRelease && (FIFO_is_full(&Deleted_QUEUE) == FIFO_FULL)){
+		return TaskDeleteQueueFull;
+	}
+
+	for(; index < (uint32)(OS_Control.NoOfActiveTasks - 1); index++){
+		OS_Control.OS_Tasks[index] = OS_Control.OS_Tasks[index + 1];
+	}
+	OS_Control.NoOfActiveTasks--;
+	OS_Control.OS_Tasks[OS_Control.NoOfActiveTasks] = NULL;
+
+	pTask->TaskState = Suspended;
+	pTask->Block_State = disabled;
+
+	if(DelayRelease){
+		FIFO_enqueue(&Deleted_QUEUE, pTask);
+	}
+	else{
+		OmarOS_ReleaseTaskStack(pTask);
+	}
+
+	return noError;
 }
 
 static void OmarOS_Create_TaskStack(Task_ref* newTask){
@@ -349,7 +950,7 @@ static void OmarOS_Create_TaskStack(Task_ref* newTask){
 
 	/* PC dummy value -> Start at task entry point*/
 	newTask->Current_PSP--;
-	*(newTask->Current_PSP) = (uint32)newTask->pf_TaskEntry;
+	*(newTask->Current_PSP) = (uint32)newTask->pConfig->pf_TaskEntry;
 
 	/* LR dummy value -> Return to thread mode with PSP */
 	newTask->Current_PSP--;
@@ -366,14 +967,60 @@ static void OmarOS_Create_TaskStack(Task_ref* newTask){
  * @Fn			- OmarOS_ActivateTask
  * @brief 		- Sends a task to the ready queue to be scheduled
  * @param [in] 	- pTask: Pointer to the task's configuration
- * @retval 		- None
+ * @retval 		- Returns noError, or TaskAdmissionRejected if the task doesn't fit under the utilization bound
  * Note			- Should only be called after calling "OmarOS_CreateTask"
  */
-void OmarOS_ActivateTask(Task_ref* pTask){
+OmarOS_errorTypes OmarOS_ActivateTask(Task_ref* pTask){
+#if (OMAROS_USE_ADMISSION_CONTROL == 1)
+	/* Admission and activation are done together in the SVC handler, the result comes back in r0 */
+	register uint32 r0 __asm("r0") = (uint32)pTask;
+
+	__asm volatile ("svc #0x05" : "+r" (r0) : : "memory");
+
+	return (OmarOS_errorTypes)r0;
+#else
 	/* Change Task State */
 	pTask->TaskState = Waiting;
 
 	OmarOS_Set_SVC(SVC_ActivateTask);
+
+	return noError;
+#endif
+}
+
+/**=============================================
+ * @Fn			- OmarOS_DeleteTask
+ * @brief 		- Removes a task from the OS and releases its stack so a later OmarOS_CreateTask can reuse it
+ * @param [in] 	- pTask: Pointer to the task's configuration
+ * @retval 		- Returns noError, or TaskDeleteQueueFull if the task was not deleted
+ * Note			- A task can delete itself, its stack is then released once it is switched out. Up to
+ * 				  DELETED_QUEUE_SIZE such stacks wait for the idle task, past that the task keeps running
+ * 				  With OMAROS_USE_REENT the C library state of the task is reclaimed by the caller, for a
+ * 				  task that deleted itself by the next OmarOS_CreateTask or OmarOS_DeleteTask
+ */
+OmarOS_errorTypes OmarOS_DeleteTask(Task_ref* pTask){
+	register uint32 r0 __asm("r0");
+	OmarOS_errorTypes retval;
+
+	/* Release stacks left by tasks that deleted themselves, this also makes room in the Deleted Queue */
+	OmarOS_ReclaimDeletedStacks();
+
+	/* Pass the task to the SVC handler in r0 right before the SVC, the result comes back in r0 */
+	r0 = (uint32)pTask;
+	__asm volatile ("svc #0x03" : "+r" (r0) : : "memory");
+	retval = (OmarOS_errorTypes)r0;
+
+#if (HEAP_TASK_QUOTAS == 1)
+	/* A task that deleted itself never gets here, its blocks are detached with its stack release */
+	if(retval == noError){
+		OmarOS_HeapReleaseOwner(pTask);
+	}
+#endif
+
+	/* Release the stack of the deleted task if it had to wait */
+	OmarOS_ReclaimDeletedStacks();
+
+	return retval;
 }
 
 /**=============================================
@@ -382,8 +1029,22 @@ void OmarOS_ActivateTask(Task_ref* pTask){
  * @param [in] 	- pTask: Pointer to the task's configuration
  * @retval 		- None
  * Note			- Should only be called after calling "OmarOS_CreateTask"
+ * 				  A task terminating itself with the scheduler suspended is switched out by OmarOS_ResumeScheduler
  */
 void OmarOS_TerminateTask(Task_ref* pTask){
+	/* Only a task terminating itself finishes a job, another task's job is abandoned */
+	if(pTask == OS_Control.CurrentTask){
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+		OmarOS_EDF_JobFinished(pTask);
+#endif
+#if (OMAROS_USE_RUNTIME_STATS == 1)
+		pTask->Stats.JobEnded = 1;
+#endif
+	}
+#if (OMAROS_USE_ADMISSION_CONTROL == 1)
+	/* Its utilization is given back, the next activation goes through admission again */
+	pTask->Admission.Admitted = 0;
+#endif
 	/* Change Task State */
 	pTask->TaskState = Suspended;
 
@@ -399,14 +1060,164 @@ void OmarOS_TerminateTask(Task_ref* pTask){
  * Note			- None
  */
 void OmarOS_TaskWait(uint32 Ticks, Task_ref* pTask){
-	pTask->TimeWaiting.Task_Block_State = enabled;
-	pTask->TimeWaiting.Ticks_Count = Ticks;
+	OmarOS_TaskWaitUntil(OS_Control.TickCount + Ticks, pTask);
+}
+
+/**=============================================
+ * @Fn			- OmarOS_TaskWaitUntil
+ * @brief 		- Sends a task to the waiting state until the tick count reaches an absolute value
+ * @param [in] 	- WakeUpTick: Tick count at which the task runs again (wraps around like OmarOS_GetTickCount)
+ * @param [in] 	- pTask: Pointer to the task's configuration
+ * @retval 		- None
+ * Note			- Returns right away if WakeUpTick is already reached
+ */
+void OmarOS_TaskWaitUntil(uint32 WakeUpTick, Task_ref* pTask){
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+	OmarOS_EDF_JobFinished(pTask);
+#endif
+	if(OMAROS_TICK_REACHED(OS_Control.TickCount, WakeUpTick)){
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+		/* No wait, the next job starts now */
+		pTask->AbsDeadline = OS_Control.TickCount + pTask->pConfig->RelativeDeadline;
+#endif
+		return;
+	}
+
+#if (OMAROS_USE_RUNTIME_STATS == 1)
+	/* A job that doesn't wait (WakeUpTick already reached) is measured together with the next one */
+	pTask->Stats.JobEnded = 1;
+#endif
+	/* A tick that passes WakeUpTick before the task is blocked wakes it on the next tick */
+	pTask->WakeUpTick = WakeUpTick;
+	pTask->Block_State = enabled;
 
 	/* Task should be blocked */
 	pTask->TaskState = Suspended;
 	OmarOS_Set_SVC(SVC_TerminateTask);
 }
 
+/**=============================================
+ * @Fn			- OmarOS_GetTickCount
+ * @brief 		- Returns the number of SysTick interrupts since OmarOS_StartOS
+ * @retval 		- Current tick count, wraps around after 2^32 ticks
+ * Note			- A single word read, safe from tasks and ISRs
+ */
+uint32 OmarOS_GetTickCount(void){
+	return OS_Control.TickCount;
+}
+
+/**=============================================
+ * @Fn			- OmarOS_GetTickCount64
+ * @brief 		- Returns the number of SysTick interrupts since OmarOS_StartOS as a 64 bits value
+ * @retval 		- Current tick count, never wraps around
+ * Note			- Lock free and without a system call, safe from tasks and ISRs
+ */
+uint64 OmarOS_GetTickCount64(void){
+	uint32 Hi, Lo;
+
+	/* Read again if a tick carried into the high word in between */
+	do{
+		Hi = OS_Control.TickCountHi;
+		Lo = OS_Control.TickCount;
+	}while(Hi != OS_Control.TickCountHi);
+
+	return ((uint64)Hi << 32) | Lo;
+}
+
+/* Privileged only (reads SysTick), combines the tick count with the SysTick current value */
+static uint64 OmarOS_ReadTimestamp(void){
+	uint32 Hi, Lo, Value;
+	uint32 Reload = SysTick->LOAD;
+
+	do{
+		Hi = OS_Control.TickCountHi;
+		Lo = OS_Control.TickCount;
+		Value = SysTick->VAL;
+	}while((Hi != OS_Control.TickCountHi) || (Lo != OS_Control.TickCount));
+
+	/* The counter reloaded but SysTick_Handler didn't run yet (caller masks it),
+	 * read the value again so it surely belongs to the new tick */
+	if(SCB->ICSR & SCB_ICSR_PENDSTSET_Msk){
+		Value = SysTick->VAL;
+		Lo++;
+		if(Lo == 0){
+			Hi++;
+		}
+	}
+
+	/* SysTick counts down from Reload to 0 */
+	return ((((uint64)Hi << 32) | Lo) * (Reload + 1)) + (Reload - Value);
+}
+
+/**=============================================
+ * @Fn			- OmarOS_GetTimestamp
+ * @brief 		- Returns a high resolution timestamp: SysTick clock cycles since OmarOS_StartOS
+ * @retval 		- Current timestamp, convert it with OMAROS_TIMESTAMP_TO_US
+ * Note			- Privileged callers and ISRs read SysTick directly, tasks go through a system call
+ */
+uint64 OmarOS_GetTimestamp(void){
+	register uint32 r0 __asm("r0");
+	register uint32 r1 __asm("r1");
+
+	if((__get_IPSR() != 0) || ((__get_CONTROL() & CONTROL_nPRIV_Msk) == 0)){
+		return OmarOS_ReadTimestamp();
+	}
+
+	/* Unprivileged tasks can't access SysTick, the SVC handler fills the stacked r0/r1 */
+	__asm volatile ("svc #0x04" : "=r" (r0), "=r" (r1) : : "memory");
+
+	return ((uint64)r1 << 32) | r0;
+}
+
+/**=============================================
+ * @Fn			- OmarOS_PeriodicInit
+ * @brief 		- Prepares a periodic release with its first release at the current tick
+ * @param [out] - pPeriodic: Pointer to the periodic object
+ * @param [in] 	- Period: Ticks between two releases
+ * @retval 		- None
+ * Note			- Called once by the task before its loop
+ */
+void OmarOS_PeriodicInit(Periodic_ref* pPeriodic, uint32 Period){
+	pPeriodic->Period = Period;
+	pPeriodic->NextRelease = OS_Control.TickCount;
+	pPeriodic->Releases = 0;
+	pPeriodic->Overruns = 0;
+	pPeriodic->LastJitter = 0;
+	pPeriodic->MaxJitter = 0;
+}
+
+/**=============================================
+ * @Fn			- OmarOS_PeriodicWait
+ * @brief 		- Waits for the next release of a periodic task
+ * @param [in] 	- pPeriodic: Pointer to the periodic object
+ * @param [in] 	- pTask: Pointer to the task's configuration
+ * @retval 		- None
+ * Note			- Releases are kept on the exact period grid whatever the job execution time,
+ * 				  releases already missed are skipped and counted in pPeriodic->Overruns
+ */
+void OmarOS_PeriodicWait(Periodic_ref* pPeriodic, Task_ref* pTask){
+	uint32 Now = OS_Control.TickCount;
+	uint32 Missed;
+
+	pPeriodic->NextRelease += pPeriodic->Period;
+
+	/* The job ran past its deadline (the next release), skip to the first release not in the past */
+	if((pPeriodic->Period != 0) && !OMAROS_TICK_REACHED(pPeriodic->NextRelease, Now)){
+		Missed = ((Now - pPeriodic->NextRelease - 1) / pPeriodic->Period) + 1;
+		pPeriodic->NextRelease += Missed * pPeriodic->Period;
+		pPeriodic->Overruns += Missed;
+	}
+
+	OmarOS_TaskWaitUntil(pPeriodic->NextRelease, pTask);
+
+	/* Release jitter: how late the task runs after its release time */
+	pPeriodic->LastJitter = OS_Control.TickCount - pPeriodic->NextRelease;
+	if(pPeriodic->LastJitter > pPeriodic->MaxJitter){
+		pPeriodic->MaxJitter = pPeriodic->LastJitter;
+	}
+	pPeriodic->Releases++;
+}
+
 /**=============================================
  * @Fn			- OmarOS_StartOS
  * @brief 		- Starts the OS scheduler to begin running tasks
@@ -423,23 +1234,27 @@ void OmarOS_StartOS(void){
 	/* Start Ticker */
 	Start_Ticker();
 
+#if (OMAROS_USE_REENT == 1)
+	/* The C library state used before this point stays with main */
+	_impure_ptr = &OS_Control.CurrentTask->Reent;
+#endif
+
 	/* Set PSP */
 	OS_SET_PSP(OS_Control.CurrentTask->Current_PSP);
 	OS_SWITCH_SP_to_PSP();
 
 	/* Switch to thread mode and unprivileged */
 	OS_SET_CPU_UNPRIVILIGED();
-	OS_Control.CurrentTask->pf_TaskEntry();
+	OS_Control.CurrentTask->pConfig->pf_TaskEntry();
 }
 
 void OmarOS_Update_TasksWaitingTime(void){
-	uint8 index;
+	OmarOS_TaskIndex index;
 	for(index = 0; index < OS_Control.NoOfActiveTasks; index++){
 		if(OS_Control.OS_Tasks[index]->TaskState == Suspended){
-			if(OS_Control.OS_Tasks[index]->TimeWaiting.Task_Block_State == enabled){
-				OS_Control.OS_Tasks[index]->TimeWaiting.Ticks_Count--;
-				if(OS_Control.OS_Tasks[index]->TimeWaiting.Ticks_Count == 0){
-					OS_Control.OS_Tasks[index]->TimeWaiting.Task_Block_State = disabled;
+			if(OS_Control.OS_Tasks[index]->Block_State == enabled){
+				if(OMAROS_TICK_REACHED(OS_Control.TickCount, OS_Control.OS_Tasks[index]->WakeUpTick)){
+					OS_Control.OS_Tasks[index]->Block_State = disabled;
 					OS_Control.OS_Tasks[index]->TaskState = Waiting;
 					OmarOS_Set_SVC(SVC_TaskWaitingTime);
 				}
@@ -448,6 +1263,119 @@ void OmarOS_Update_TasksWaitingTime(void){
 	}
 }
 
+#if (OMAROS_USE_ADMISSION_CONTROL == 1)
+/* Liu & Layland bound n(2^(1/n) - 1) in parts per thousand, rounded down, it tends to ln(2) */
+static const uint16 OS_LIU_LAYLAND_BOUND[] = {1000, 828, 779, 756, 743, 734, 728, 724, 720, 717};
+
+/* Called from the SVC handler (or before the OS starts), takes a share of the CPU for the task */
+static OmarOS_errorTypes OmarOS_AdmitTask(Task_ref* pTask){
+	uint32 Utilization = pTask->Admission.Utilization;
+	uint32 NoOfAdmitted = 1, Bound;
+	OmarOS_TaskIndex index;
+
+	/* Tasks without a budget and tasks already holding their share are activated as usual */
+	if((pTask->pConfig->Budget == 0) || pTask->Admission.Admitted){
+		return noError;
+	}
+
+	for(index = 0; index < OS_Control.NoOfActiveTasks; index++){
+		if((OS_Control.OS_Tasks[index] != pTask) && OS_Control.OS_Tasks[index]->Admission.Admitted){
+			Utilization += OS_Control.OS_Tasks[index]->Admission.Utilization;
+			NoOfAdmitted++;
+		}
+	}
+
+#if (OMAROS_ADMISSION_BOUND != 0)
+	Bound = OMAROS_ADMISSION_BOUND;
+#elif (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+	Bound = 1000;
+#else
+	Bound = (NoOfAdmitted <= (sizeof(OS_LIU_LAYLAND_BOUND) / sizeof(OS_LIU_LAYLAND_BOUND[0]))) ?
+			OS_LIU_LAYLAND_BOUND[NoOfAdmitted - 1] : 693;
+#endif
+	if(Utilization > (Bound * 1000UL)){
+		return TaskAdmissionRejected;
+	}
+
+	pTask->Admission.Admitted = 1;
+	pTask->Admission.Used = 0;
+	pTask->Admission.ReplenishTick = OS_Control.TickCount + pTask->pConfig->Period;
+	if(pTask->Admission.Demoted){
+		pTask->Admission.Demoted = 0;
+#if (OMAROS_BUDGET_OVERRUN_ACTION == OMAROS_BUDGET_DEMOTE)
+		OmarOS_SetBasePriority(pTask, OMAROS_BUDGET_DEMOTE_PRIORITY, pTask->pConfig->Priority);
+#endif
+	}
+
+	return noError;
+}
+
+#if (OMAROS_BUDGET_OVERRUN_ACTION == OMAROS_BUDGET_DEMOTE)
+/* The base priority is the one a task runs at without a mutex: its configured priority, or
+ * OMAROS_BUDGET_DEMOTE_PRIORITY while demoted. Only a task running at its old base is moved,
+ * a task raised by a priority ceiling keeps the ceiling and gets the new base on the release */
+static void OmarOS_SetBasePriority(Task_ref* pTask, uint8 OldBase, uint8 NewBase){
+	if(pTask->Priority == OldBase){
+		pTask->Priority = NewBase;
+	}
+}
+#endif
+
+/* Called by SysTick_Handler: replenishes budgets at the end of each period and charges the
+ * interrupted task with the tick, a task that used its whole budget is demoted or suspended */
+static void OmarOS_Update_TaskBudgets(void){
+	Task_ref* pTask;
+	OmarOS_TaskIndex index;
+	uint8 Reschedule = 0;
+
+	for(index = 0; index < OS_Control.NoOfActiveTasks; index++){
+		pTask = OS_Control.OS_Tasks[index];
+		if(pTask->Admission.Admitted && OMAROS_TICK_REACHED(OS_Control.TickCount, pTask->Admission.ReplenishTick)){
+			pTask->Admission.Used = 0;
+			pTask->Admission.ReplenishTick += pTask->pConfig->Period;
+			if(OMAROS_TICK_REACHED(OS_Control.TickCount, pTask->Admission.ReplenishTick)){
+				/* The task didn't run for whole periods, restart its period grid now */
+				pTask->Admission.ReplenishTick = OS_Control.TickCount + pTask->pConfig->Period;
+			}
+			if(pTask->Admission.Demoted){
+				/* A suspended task is woken by OmarOS_Update_TasksWaitingTime on the same tick */
+				pTask->Admission.Demoted = 0;
+#if (OMAROS_BUDGET_OVERRUN_ACTION == OMAROS_BUDGET_DEMOTE)
+				OmarOS_SetBasePriority(pTask, OMAROS_BUDGET_DEMOTE_PRIORITY, pTask->pConfig->Priority);
+				Reschedule = 1;
+#endif
+			}
+		}
+	}
+
+	/* The tick is charged whole to the task it interrupted */
+	pTask = OS_Control.CurrentTask;
+	if(pTask->Admission.Admitted && !pTask->Admission.Demoted && (pTask->TaskState == Running)){
+		pTask->Admission.Used++;
+		if(pTask->Admission.Used >= pTask->pConfig->Budget){
+			pTask->Admission.Overruns++;
+			pTask->Admission.Demoted = 1;
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+			OmarOS_EDF_Background(pTask);
+#endif
+#if (OMAROS_BUDGET_OVERRUN_ACTION == OMAROS_BUDGET_DEMOTE)
+			OmarOS_SetBasePriority(pTask, pTask->pConfig->Priority, OMAROS_BUDGET_DEMOTE_PRIORITY);
+#else
+			pTask->WakeUpTick = pTask->Admission.ReplenishTick;
+			pTask->Block_State = enabled;
+			pTask->TaskState = Suspended;
+#endif
+			Reschedule = 1;
+		}
+	}
+
+	if(Reschedule){
+		OmarOS_Set_SVC(SVC_ActivateTask);
+	}
+}
+#endif
+
+#if (OMAROS_USE_MUTEX == 1)
 /**=============================================
  * @Fn			- OmarOS_AcquireMutex
  * @brief 		- Tries to acquire a mutex if available
@@ -496,6 +1424,15 @@ void OmarOS_ReleaseMutex(Mutex_ref* pMutex){
 		if(pMutex->PriorityCeiling.state == PriorityCeiling_enabled){
 		/* Restore current task priority */
 		pMutex->CurrentTUser->Priority = pMutex->PriorityCeiling.old_priority;
+#if ((OMAROS_USE_ADMISSION_CONTROL == 1) && (OMAROS_BUDGET_OVERRUN_ACTION == OMAROS_BUDGET_DEMOTE))
+		/* The budget may have been used up or replenished while the ceiling was held */
+		if(pMutex->CurrentTUser->Admission.Demoted){
+			OmarOS_SetBasePriority(pMutex->CurrentTUser, pMutex->CurrentTUser->pConfig->Priority, OMAROS_BUDGET_DEMOTE_PRIORITY);
+		}
+		else{
+			OmarOS_SetBasePriority(pMutex->CurrentTUser, OMAROS_BUDGET_DEMOTE_PRIORITY, pMutex->CurrentTUser->pConfig->Priority);
+		}
+#endif
 		}
 
 		if(pMutex->NextTUser == NULL){
@@ -518,3 +1455,149 @@ void OmarOS_ReleaseMutex(Mutex_ref* pMutex){
 		}
 	}
 }
+
+/**=============================================
+ * @Fn			- OmarOS_RegisterMutex
+ * @brief 		- Adds a mutex to the list searched by OmarOS_FindMutex
+ * @param [in] 	- pMutex: Pointer to the Mutex, its NameHash must be set (OMAROS_MUTEX_NAME)
+ * @retval 		- None
+ * Note			- Only needed for mutexes that are looked up by name, a mutex must be registered once
+ */
+void OmarOS_RegisterMutex(Mutex_ref* pMutex){
+	OmarOS_SuspendScheduler();
+	/* The mutex is linked before it becomes the head, a task walking the list never sees it half added */
+	pMutex->pNextMutex = OS_Control.MutexList;
+	OS_Control.MutexList = pMutex;
+	OmarOS_ResumeScheduler();
+}
+
+/**=============================================
+ * @Fn			- OmarOS_FindMutex
+ * @brief 		- Returns the registered mutex whose name hashes to NameHash
+ * @param [in] 	- NameHash: OMAROS_NAME_HASH("name") or OmarOS_NameHash(name)
+ * @retval 		- Pointer to the Mutex, NULL if none was found
+ * Note			- Walks the registered mutexes comparing one word each, no string is compared
+ */
+Mutex_ref* OmarOS_FindMutex(uint32 NameHash){
+	Mutex_ref* pMutex = OS_Control.MutexList;
+	while((pMutex != NULL) && (pMutex->NameHash != NameHash)){
+		pMutex = pMutex->pNextMutex;
+	}
+	return pMutex;
+}
+#endif
+
+/**=============================================
+ * @Fn			- OmarOS_NameHash
+ * @brief 		- Hashes a name at run time the way OMAROS_NAME_HASH does at build time
+ * @param [in] 	- pName: Pointer to the null terminated name
+ * @retval 		- 32 bits FNV-1a hash of the first OMAROS_NAME_HASH_MAX_LENGTH characters
+ * Note			- For names that are only known at run time (received from a shell or a host tool)
+ */
+uint32 OmarOS_NameHash(const char* pName){
+	uint32 Hash = OMAROS_NAME_HASH_OFFSET;
+	uint32 index;
+	if(pName != NULL){
+		for(index = 0; (index < OMAROS_NAME_HASH_MAX_LENGTH) && (pName[index] != '\0'); index++){
+			Hash = (Hash ^ (uint8)pName[index]) * OMAROS_NAME_HASH_PRIME;
+		}
+	}
+	return Hash;
+}
+
+/**=============================================
+ * @Fn			- OmarOS_FindTask
+ * @brief 		- Returns the task in the Scheduling Table whose name hashes to NameHash
+ * @param [in] 	- NameHash: OMAROS_NAME_HASH("name") or OmarOS_NameHash(name)
+ * @retval 		- Pointer to the task, NULL if none was found
+ * Note			- Tasks created with NameHash 0 are hashed from their TaskName (OMAROS_USE_NAMES == 1)
+ */
+Task_ref* OmarOS_FindTask(uint32 NameHash){
+	Task_ref* pTask = NULL;
+	uint32 TaskHash;
+	OmarOS_TaskIndex index;
+
+	for(index = 0; index < OS_Control.NoOfActiveTasks; index++){
+		TaskHash = OS_Control.OS_Tasks[index]->pConfig->NameHash;
+#if (OMAROS_USE_NAMES == 1)
+		if((TaskHash == 0) && (OS_Control.OS_Tasks[index]->pConfig->TaskName != NULL)){
+			TaskHash = OmarOS_NameHash(OS_Control.OS_Tasks[index]->pConfig->TaskName);
+		}
+#endif
+		if(TaskHash == NameHash){
+			pTask = OS_Control.OS_Tasks[index];
+			break;
+		}
+	}
+	return pTask;
+}
+
+/**=============================================
+ * @Fn			- OmarOS_SuspendScheduler
+ * @brief 		- Prevents context switches until OmarOS_ResumeScheduler is called
+ * @retval 		- None
+ * Note			- Calls can be nested, interrupts are still serviced while the scheduler is suspended
+ * 				  A task must not wait or block on a mutex while the scheduler is suspended. It may terminate
+ * 				  itself only under a single level of suspension, followed by OmarOS_ResumeScheduler: the
+ * 				  switch is pended and done by the resume, the task runs until then
+ */
+void OmarOS_SuspendScheduler(void){
+	OS_Control.SchedulerLockCount++;
+}
+
+/**=============================================
+ * @Fn			- OmarOS_ResumeScheduler
+ * @brief 		- Allows context switches again and performs any switch requested while suspended
+ * @retval 		- None
+ * Note			- Must be called once for every call to OmarOS_SuspendScheduler
+ */
+void OmarOS_ResumeScheduler(void){
+	if(OS_Control.SchedulerLockCount != 0){
+		OS_Control.SchedulerLockCount--;
+		if((OS_Control.SchedulerLockCount == 0) && (OS_Control.SwitchPending != 0)){
+			OS_Control.SwitchPending = 0;
+			if(OS_Control.OS_ModeID == OS_Running){
+				OmarOS_Set_SVC(SVC_ActivateTask);
+			}
+		}
+	}
+}
+
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+/**=============================================
+ * @Fn			- OmarOS_GetDeadlineMisses
+ * @brief 		- Returns the number of jobs of all tasks that finished after their deadline
+ * @retval 		- Deadline misses since OmarOS_StartOS
+ * Note			- None
+ */
+uint32 OmarOS_GetDeadlineMisses(void){
+	return OS_Control.DeadlineMisses;
+}
+#endif
+
+#if (OMAROS_USE_STATS == 1)
+/**=============================================
+ * @Fn			- OmarOS_GetSchedulerStats
+ * @brief 		- Reports how many context switches were done and how many were skipped
+ * @param [out] - pStats: Pointer to the structure to be filled
+ * @retval 		- None
+ * Note			- None
+ */
+void OmarOS_GetSchedulerStats(Scheduler_stats* pStats){
+	*pStats = OS_Control.Stats;
+}
+#endif
+
+/**=============================================
+ * @Fn			- OmarOS_GetCurrentTask
+ * @brief 		- Returns the task that is currently running
+ * @retval 		- Pointer to the running task's configuration, NULL if the OS is not started yet
+ * Note			- None
+ */
+Task_ref* OmarOS_GetCurrentTask(void){
+	Task_ref* pTask = NULL;
+	if(OS_Control.OS_ModeID == OS_Running){
+		pTask = OS_Control.CurrentTask;
+	}
+	return pTask;
+}
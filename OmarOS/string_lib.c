@@ -9,6 +9,79 @@
 
 #include "string_lib.h"
 
+/* Words at least this long are searched with a Boyer-Moore-Horspool skip table */
+#ifndef STRING_SEARCH_SKIP_MIN_LENGTH
+#define STRING_SEARCH_SKIP_MIN_LENGTH	4
+#endif
+
+/* Entries in the skip table, which is on the stack of the searching task. Characters share an entry
+ * through their low bits (64: a digit and a lower case letter), must be a power of 2 up to 256 */
+#ifndef STRING_SEARCH_SKIP_SIZE
+#define STRING_SEARCH_SKIP_SIZE			64
+#endif
+
+#if (STRING_SEARCH_SKIP_SIZE == 0) || (STRING_SEARCH_SKIP_SIZE > 256) || ((STRING_SEARCH_SKIP_SIZE & (STRING_SEARCH_SKIP_SIZE - 1)) != 0)
+#error "STRING_SEARCH_SKIP_SIZE must be a power of 2 up to 256"
+#endif
+
+/* Skip table entry of a (folded) character */
+#define STRING_SKIP(c)			((c) & (STRING_SEARCH_SKIP_SIZE - 1))
+
+/* 1: Length, copy, compare, case conversion and memory set work on aligned words (4 characters on
+ * Cortex-M3) once both pointers reach a word boundary. Word loads may read the bytes after the
+ * terminating null inside the same aligned word, they never cross into another word
+ * 0: Byte by byte */
+#ifndef STRING_WORD_AT_A_TIME
+#define STRING_WORD_AT_A_TIME			1
+#endif
+
+#if (STRING_WORD_AT_A_TIME == 1)
+/* Characters read as a word, may_alias keeps these accesses valid under strict aliasing */
+typedef unsigned long __attribute__((__may_alias__)) STRING_word;
+
+#define STRING_WORD_SIZE			sizeof(STRING_word)
+#define STRING_WORD_ONES			((unsigned long)-1 / 0xFF)		/* 0x01 in every byte */
+#define STRING_WORD_HIGHS			(STRING_WORD_ONES * 0x80)		/* 0x80 in every byte */
+#define STRING_WORD_OFFSET(ptr)		((unsigned long)(ptr) & (STRING_WORD_SIZE - 1))
+
+/* Not 0 if one of the bytes of "word" is 0 */
+#define STRING_WORD_HAS_ZERO(word)	(((word) - STRING_WORD_ONES) & ~(word) & STRING_WORD_HIGHS)
+
+/* 0x80 in every byte of "word" holding an ASCII character from "first" to "last" (first > 0) */
+#define STRING_WORD_IN_RANGE(word, first, last)	\
+	((((word) & ~STRING_WORD_HIGHS) + (STRING_WORD_ONES * (0x80 - (first)))) & \
+	~(((word) & ~STRING_WORD_HIGHS) + (STRING_WORD_ONES * (0x7F - (last)))) & ~(word) & STRING_WORD_HIGHS)
+
+/* Case conversion of a whole word, 0x80 >> 2 is the 0x20 case bit */
+#define STRING_WORD_TO_LOWER(word)	((word) ^ (STRING_WORD_IN_RANGE(word, 'A', 'Z') >> 2))
+#define STRING_WORD_TO_UPPER(word)	((word) ^ (STRING_WORD_IN_RANGE(word, 'a', 'z') >> 2))
+#endif
+
+/* Case conversion tables, indexed by the character. Only ASCII letters change */
+#define STRING_LOWER(c)		((((c) >= 'A') && ((c) <= 'Z')) ? ((c) + 32) : (c))
+#define STRING_UPPER(c)		((((c) >= 'a') && ((c) <= 'z')) ? ((c) - 32) : (c))
+#define STRING_ROW(f, c)	f(c), f(c + 1), f(c + 2), f(c + 3), f(c + 4), f(c + 5), f(c + 6), f(c + 7), \
+							f(c + 8), f(c + 9), f(c + 10), f(c + 11), f(c + 12), f(c + 13), f(c + 14), f(c + 15)
+#define STRING_TABLE(f)		STRING_ROW(f, 0x00), STRING_ROW(f, 0x10), STRING_ROW(f, 0x20), STRING_ROW(f, 0x30), \
+							STRING_ROW(f, 0x40), STRING_ROW(f, 0x50), STRING_ROW(f, 0x60), STRING_ROW(f, 0x70), \
+							STRING_ROW(f, 0x80), STRING_ROW(f, 0x90), STRING_ROW(f, 0xA0), STRING_ROW(f, 0xB0), \
+							STRING_ROW(f, 0xC0), STRING_ROW(f, 0xD0), STRING_ROW(f, 0xE0), STRING_ROW(f, 0xF0)
+
+const unsigned char STRING_lower_table[256] = { STRING_TABLE(STRING_LOWER) };
+static const unsigned char STRING_upper_table[256] = { STRING_TABLE(STRING_UPPER) };
+
+/* Character through a case table, or as it is when "table" is NULL */
+#define STRING_FOLD(table, c)	((NULL != (table)) ? (table)[(c)] : (c))
+
+#if defined(__ARM_FEATURE_UNALIGNED)
+/* Word read from any address, the core splits unaligned LDR/STR itself */
+typedef unsigned long __attribute__((__may_alias__, __aligned__(1))) STRING_unaligned_word;
+#endif
+
+static unsigned long STRING_measure(const unsigned char* str);
+static unsigned char STRING_equal(const unsigned char* str1, const unsigned char* str2, unsigned long length, const unsigned char* fold);
+static const unsigned char* STRING_search(const unsigned char* str, unsigned long str_length, const unsigned char* word, unsigned long word_length, unsigned char reverse, const unsigned char* fold);
+
 /**=============================================
   * @Fn				- STRING_convert_upperCase
   * @brief 			- Converts all alphabetical characters in string "str" to upper case
@@ -20,13 +93,23 @@
 void STRING_convert_upperCase(unsigned char* str){
 	/* Validate that we are not accessing a null pointer */
 	if(NULL != str){
+#if (STRING_WORD_AT_A_TIME == 1)
+		/* Whole words are converted while they hold no terminating null */
+		while((0 != STRING_WORD_OFFSET(str)) && (*str)){
+			*str = STRING_upper_table[*str];
+			str++;
+		}
+		if(0 == STRING_WORD_OFFSET(str)){
+			while(!STRING_WORD_HAS_ZERO(*(STRING_word*)str)){
+				*(STRING_word*)str = STRING_WORD_TO_UPPER(*(STRING_word*)str);
+				str += STRING_WORD_SIZE;
+			}
+		}
+		else{ /* Do Nothing */ }
+#endif
 		/* Loop on array characters until finding a terminating null */
 		while(*str){
-			/* If lower case character is found convert it to upper case */
-			if(('a' <= *str) && ('z' >= *str)){
-				*str -= 32;
-			}
-			else{ /* Do Nothing */ }
+			*str = STRING_upper_table[*str];
 			str++;
 		}
 	}
@@ -44,13 +127,23 @@ void STRING_convert_upperCase(unsigned char* str){
 void STRING_convert_lowerCase(unsigned char* str){
 	/* Validate that we are not accessing a null pointer */
 	if(NULL != str){
+#if (STRING_WORD_AT_A_TIME == 1)
+		/* Whole words are converted while they hold no terminating null */
+		while((0 != STRING_WORD_OFFSET(str)) && (*str)){
+			*str = STRING_lower_table[*str];
+			str++;
+		}
+		if(0 == STRING_WORD_OFFSET(str)){
+			while(!STRING_WORD_HAS_ZERO(*(STRING_word*)str)){
+				*(STRING_word*)str = STRING_WORD_TO_LOWER(*(STRING_word*)str);
+				str += STRING_WORD_SIZE;
+			}
+		}
+		else{ /* Do Nothing */ }
+#endif
 		/* Loop on array characters until finding a terminating null */
 		while(*str){
-			/* If an upper case character is found convert it to lower case */
-			if(('A' <= *str) && ('Z' >= *str)){
-				*str += 32;
-			}
-			else{ /* Do Nothing */ }
+			*str = STRING_lower_table[*str];
 			str++;
 		}
 	}
@@ -70,9 +163,30 @@ void STRING_convert_lowerCase(unsigned char* str){
 void STRING_set_memoryLocation(unsigned char* str, unsigned char value, unsigned short size){
 	/* Validate that we are not accessing a null pointer */
 	if(NULL != str){
-		unsigned int index;
+		unsigned int index = 0;
+#if (STRING_WORD_AT_A_TIME == 1)
+		STRING_word pattern = STRING_WORD_ONES * value;
+
+		/* Bytes up to the first word boundary */
+		for(; (index < size) && (0 != STRING_WORD_OFFSET(str)); index++){
+			*str++ = value;
+		}
+
+		/* Four words per iteration, compiled to STRD/STM bursts */
+		for(; (size - index) >= (4 * STRING_WORD_SIZE); index += 4 * STRING_WORD_SIZE){
+			((STRING_word*)str)[0] = pattern;
+			((STRING_word*)str)[1] = pattern;
+			((STRING_word*)str)[2] = pattern;
+			((STRING_word*)str)[3] = pattern;
+			str += 4 * STRING_WORD_SIZE;
+		}
+		for(; (size - index) >= STRING_WORD_SIZE; index += STRING_WORD_SIZE){
+			*(STRING_word*)str = pattern;
+			str += STRING_WORD_SIZE;
+		}
+#endif
 		/* Set every byte of array "str" to "value" */
-		for(index = 0; index < size; index++){
+		for(; index < size; index++){
 			*str++ = value;
 		}
 	}
@@ -207,6 +321,23 @@ signed char STRING_compare_caseSensitive(const unsigned char* str1, const unsign
 	signed char ret_val = 0;
 	/* Validate that we are not accessing a null pointer */
 	if( (NULL != str1) && (NULL != str2) ){
+#if (STRING_WORD_AT_A_TIME == 1)
+		/* Skip the identical words, the byte loop below finds the difference or terminator inside the last one */
+		if(STRING_WORD_OFFSET(str1) == STRING_WORD_OFFSET(str2)){
+			while((0 != STRING_WORD_OFFSET(str1)) && ('\0' != *str1) && (*str1 == *str2)){
+				str1++;
+				str2++;
+			}
+			if(0 == STRING_WORD_OFFSET(str1)){
+				while((*(const STRING_word*)str1 == *(const STRING_word*)str2) && !STRING_WORD_HAS_ZERO(*(const STRING_word*)str1)){
+					str1 += STRING_WORD_SIZE;
+					str2 += STRING_WORD_SIZE;
+				}
+			}
+			else{ /* Do Nothing */ }
+		}
+		else{ /* Do Nothing */ }
+#endif
 		/* Navigate in the two strings */
 		while( ('\0' != *str1) && ('\0' != *str2) ){
 			/* Check if two characters are identicals */
@@ -242,58 +373,34 @@ signed char STRING_compare_caseInsensitive(const unsigned char* str1, const unsi
 	signed char ret_val = 0;
 	/* Validate that we are not accessing a null pointer */
 	if( (NULL != str1) && (NULL != str2) ){
-		unsigned char temp_compare_value;
-		/* Navigate in the two strings */
-		while( ('\0' != *str1) && ('\0' != *str2) ){
-			/* Check if two characters are identicals */
-			if(*str1 != *str2){
-				/* Check if *str1 is just the other case character of *str2 */
-				if( ('A' <= *str1) && ('Z' >= *str1) ){
-					/* If *str1 is upper case, convert to lower case and recheck if identical to *str2 */
-					temp_compare_value = *str1 + 32;
-					if(*str2 == temp_compare_value){
-						/* Character is the same but different in case */
-						continue;
-					}
-					else{
-						/* Character is different */
-						if(*str1 < *str2){
-							ret_val = -1;
-						}
-						else{
-							ret_val = 1;
-						}
-						break;
-					}
+#if (STRING_WORD_AT_A_TIME == 1)
+		/* Skip the words that are equal in lower case, the byte loop below finds the difference or terminator inside the last one */
+		if(STRING_WORD_OFFSET(str1) == STRING_WORD_OFFSET(str2)){
+			while((0 != STRING_WORD_OFFSET(str1)) && ('\0' != *str1) && (STRING_lower_table[*str1] == STRING_lower_table[*str2])){
+				str1++;
+				str2++;
+			}
+			if(0 == STRING_WORD_OFFSET(str1)){
+				while(!STRING_WORD_HAS_ZERO(*(const STRING_word*)str1)
+						&& (STRING_WORD_TO_LOWER(*(const STRING_word*)str1) == STRING_WORD_TO_LOWER(*(const STRING_word*)str2))){
+					str1 += STRING_WORD_SIZE;
+					str2 += STRING_WORD_SIZE;
 				}
-				else if( ('a' <= *str1) && ('z' >= *str1) ){
-					/* If *str1 is lower case, convert to upper case and recheck if identical to *str2 */
-					temp_compare_value = *str1 - 32;
-					if(*str2 == temp_compare_value){
-						/* Character is the same but different in case */
-						continue;
-					}
-					else{
-						/* Character is different */
-						if(*str1 < *str2){
-							ret_val = -1;
-						}
-						else{
-							ret_val = 1;
-						}
-						break;
-					}
+			}
+			else{ /* Do Nothing */ }
+		}
+		else{ /* Do Nothing */ }
+#endif
+		/* Navigate in the two strings, characters are compared in lower case */
+		while( ('\0' != *str1) && ('\0' != *str2) ){
+			if(STRING_lower_table[*str1] != STRING_lower_table[*str2]){
+				if(STRING_lower_table[*str1] < STRING_lower_table[*str2]){
+					ret_val = -1;
 				}
 				else{
-					/* Characters are not an alphabetic and are different */
-					if(*str1 < *str2){
-						ret_val = -1;
-					}
-					else{
-						ret_val = 1;
-					}
-					break;
+					ret_val = 1;
 				}
+				break;
 			}
 			else{
 				str1++;
@@ -319,9 +426,26 @@ signed char STRING_compare_caseSensitive_length(const unsigned char* str1, const
 	signed char ret_val = 0;
 	/* Validate that we are not accessing a null pointer */
 	if( (NULL != str1) && (NULL != str2) ){
-		unsigned short index;
+		unsigned short index = 0;
+#if (STRING_WORD_AT_A_TIME == 1)
+		/* Skip the identical words, the byte loop below finds the difference or terminator inside the last one */
+		if(STRING_WORD_OFFSET(str1) == STRING_WORD_OFFSET(str2)){
+			while((index < length) && (0 != STRING_WORD_OFFSET(&str1[index])) && ('\0' != str1[index]) && (str1[index] == str2[index])){
+				index++;
+			}
+			if(0 == STRING_WORD_OFFSET(&str1[index])){
+				/* index never passes length, the promoted difference is not negative */
+				while(((size_t)(length - index) >= STRING_WORD_SIZE) && (*(const STRING_word*)&str1[index] == *(const STRING_word*)&str2[index])
+						&& !STRING_WORD_HAS_ZERO(*(const STRING_word*)&str1[index])){
+					index += STRING_WORD_SIZE;
+				}
+			}
+			else{ /* Do Nothing */ }
+		}
+		else{ /* Do Nothing */ }
+#endif
 		/* Navigate in the two strings */
-		for(index = 0; (index < length) && ('\0' != *str1) && ('\0' != *str2); index++){
+		for(; (index < length) && ('\0' != str1[index]) && ('\0' != str2[index]); index++){
 			/* Check if two characters are identicals */
 			if(str1[index] != str2[index]){
 				if(str1[index] < str2[index]){
@@ -353,59 +477,35 @@ signed char STRING_compare_caseInsensitive_length(const unsigned char* str1, con
 	signed char ret_val = 0;
 	/* Validate that we are not accessing a null pointer */
 	if( (NULL != str1) && (NULL != str2) ){
-		unsigned char temp_compare_value;
-		unsigned short index;
-		/* Navigate in the two strings */
-		for(index = 0; (index < length) && ('\0' != *str1) && ('\0' != *str2); index++){
-			/* Check if two characters are identicals */
-			if(str1[index] != str2[index]){
-				/* Check if str1[index] is just the other case character of str2[index] */
-				if( ('A' <= str1[index]) && ('Z' >= str1[index]) ){
-					/* If str1[index] is upper case, convert to lower case and recheck if identical to str2[index] */
-					temp_compare_value = str1[index] + 32;
-					if(str2[index] == temp_compare_value){
-						/* Character is the same but different in case */
-						continue;
-					}
-					else{
-						/* Character is different */
-						if(str1[index] < str2[index]){
-							ret_val = -1;
-						}
-						else{
-							ret_val = 1;
-						}
-						break;
-					}
+		unsigned short index = 0;
+#if (STRING_WORD_AT_A_TIME == 1)
+		/* Skip the words that are equal in lower case, the byte loop below finds the difference or terminator inside the last one */
+		if(STRING_WORD_OFFSET(str1) == STRING_WORD_OFFSET(str2)){
+			while((index < length) && (0 != STRING_WORD_OFFSET(&str1[index])) && ('\0' != str1[index])
+					&& (STRING_lower_table[str1[index]] == STRING_lower_table[str2[index]])){
+				index++;
+			}
+			if(0 == STRING_WORD_OFFSET(&str1[index])){
+				/* index never passes length, the promoted difference is not negative */
+				while(((size_t)(length - index) >= STRING_WORD_SIZE) && !STRING_WORD_HAS_ZERO(*(const STRING_word*)&str1[index])
+						&& (STRING_WORD_TO_LOWER(*(const STRING_word*)&str1[index]) == STRING_WORD_TO_LOWER(*(const STRING_word*)&str2[index]))){
+					index += STRING_WORD_SIZE;
 				}
-				else if( ('a' <= str1[index]) && ('z' >= str1[index]) ){
-					/* If str1[index] is lower case, convert to upper case and recheck if identical to str2[index] */
-					temp_compare_value = str1[index] - 32;
-					if(str2[index] == temp_compare_value){
-						/* Character is the same but different in case */
-						continue;
-					}
-					else{
-						/* Character is different */
-						if(str1[index] < str2[index]){
-							ret_val = -1;
-						}
-						else{
-							ret_val = 1;
-						}
-						break;
-					}
+			}
+			else{ /* Do Nothing */ }
+		}
+		else{ /* Do Nothing */ }
+#endif
+		/* Navigate in the two strings, characters are compared in lower case */
+		for(; (index < length) && ('\0' != str1[index]) && ('\0' != str2[index]); index++){
+			if(STRING_lower_table[str1[index]] != STRING_lower_table[str2[index]]){
+				if(STRING_lower_table[str1[index]] < STRING_lower_table[str2[index]]){
+					ret_val = -1;
 				}
 				else{
-					/* Characters are not an alphabetic and are different */
-					if(str1[index] < str2[index]){
-						ret_val = -1;
-					}
-					else{
-						ret_val = 1;
-					}
-					break;
+					ret_val = 1;
 				}
+				break;
 			}
 			else{ /* Do Nothing */ }
 		}
@@ -424,16 +524,32 @@ signed char STRING_compare_caseInsensitive_length(const unsigned char* str1, con
   * Note			- None
   */
 unsigned short STRING_copy(const unsigned char* src_str, unsigned char* des_str){
-	unsigned short index = 0;
+	unsigned long index = 0;
 	/* Validate that we are not accessing a null pointer */
 	if( (NULL != src_str) && (NULL != des_str) ){
+#if (STRING_WORD_AT_A_TIME == 1)
+		/* Whole words are copied while they hold no terminating null, both strings must share the word offset */
+		if(STRING_WORD_OFFSET(src_str) == STRING_WORD_OFFSET(des_str)){
+			for(; (0 != STRING_WORD_OFFSET(&src_str[index])) && ('\0' != src_str[index]); index++){
+				des_str[index] = src_str[index];
+			}
+			if(0 == STRING_WORD_OFFSET(&src_str[index])){
+				while(!STRING_WORD_HAS_ZERO(*(const STRING_word*)&src_str[index])){
+					*(STRING_word*)&des_str[index] = *(const STRING_word*)&src_str[index];
+					index += STRING_WORD_SIZE;
+				}
+			}
+			else{ /* Do Nothing */ }
+		}
+		else{ /* Do Nothing */ }
+#endif
 		for(; '\0' != src_str[index]; index++){
 			des_str[index] = src_str[index];
 		}
 		des_str[index] = '\0';
 	}
 	else{ /* Do Nothing */ }
-	return index;
+	return (unsigned short)index;
 }
 
 /**=============================================
@@ -469,9 +585,7 @@ unsigned short STRING_length(const unsigned char* str){
 	unsigned short length = 0;
 	/* Validate that we are not accessing a null pointer */
 	if(NULL != str){
-		while('\0' != str[length]){
-			length++;
-		}
+		length = (unsigned short)STRING_measure(str);
 	}
 	else{ /* Do Nothing */ }
 	return length;
@@ -484,33 +598,14 @@ unsigned short STRING_length(const unsigned char* str){
   * @param [in] 	- word: Pointer to the string to find the first occurrence of it
   * @param [out] 	- None
   * @retval 		- Pointer to the location of the first occurrence of "word" in "str"
-  * Note			- None
+  * Note			- Returns NULL if "word" was not found, an empty "word" is found at the start of "str"
   */
 unsigned char* STRING_word_firstOccurrence(const unsigned char* str, const unsigned char* word){
 	unsigned char* ret_val = NULL;
 
 	/* Validate that we are not accessing a null pointer */
 	if( (NULL != str) && (NULL != word) ){
-		unsigned short str_index = 0;
-		unsigned short word_index;
-		while('\0' != str[str_index]){
-			/* Reset flag */
-			unsigned int found_flag = 0;
-			for(word_index = 0; ( ('\0' != word[word_index]) && ('\0' != str[str_index + word_index]) ) ; word_index++){
-				/* If characters are not equal, set a flag */
-				if(str[str_index + word_index] != word[word_index]){
-					found_flag |= 1;
-				}
-				else{ /* Do Nothing */ }
-			}
-			if(0 == found_flag){
-				/* If found, set return value and break while loop */
-				ret_val = (unsigned char*)&(str[str_index]);
-				break;
-			}
-			else{ /* Do Nothing */ }
-			str_index++;
-		}
+		ret_val = (unsigned char*)STRING_search(str, STRING_measure(str), word, STRING_measure(word), 0, NULL);
 	}
 	else{ /* Do Nothing */ }
 	return ret_val;
@@ -523,31 +618,344 @@ unsigned char* STRING_word_firstOccurrence(const unsigned char* str, const unsig
   * @param [in] 	- word: Pointer to the string to find the last occurrence of it
   * @param [out] 	- None
   * @retval 		- Pointer to the location of the last occurrence of "word" in "str"
-  * Note			- None
+  * Note			- Returns NULL if "word" was not found, an empty "word" is found at the end of "str"
   */
 unsigned char* STRING_word_lastOccurrence(const unsigned char* str, const unsigned char* word){
 	unsigned char* ret_val = NULL;
 
 	/* Validate that we are not accessing a null pointer */
 	if( (NULL != str) && (NULL != word) ){
-		unsigned short str_index = 0;
-		unsigned short word_index;
-		while('\0' != str[str_index]){
-			/* Reset flag */
-			unsigned int found_flag = 0;
-			for(word_index = 0; ( ('\0' != word[word_index]) && ('\0' != str[str_index + word_index]) ) ; word_index++){
-				/* If characters are not equal, set a flag */
-				if(str[str_index + word_index] != word[word_index]){
-					found_flag |= 1;
+		/* Scans backward from the end, the first match found is the last one */
+		ret_val = (unsigned char*)STRING_search(str, STRING_measure(str), word, STRING_measure(word), 1, NULL);
+	}
+	else{ /* Do Nothing */ }
+	return ret_val;
+}
+
+/**=============================================
+  * @Fn				- STRING_word_firstOccurrence_caseInsensitive
+  * @brief 			- Returns pointer to first occurrence of "word" in "str" ignoring the letters case
+  * @param [in] 	- str : Pointer to the array containing the string to search for
+  * @param [in] 	- word: Pointer to the string to find the first occurrence of it
+  * @param [out] 	- None
+  * @retval 		- Pointer to the location of the first occurrence of "word" in "str"
+  * Note			- Returns NULL if "word" was not found, an empty "word" is found at the start of "str"
+  */
+unsigned char* STRING_word_firstOccurrence_caseInsensitive(const unsigned char* str, const unsigned char* word){
+	unsigned char* ret_val = NULL;
+
+	/* Validate that we are not accessing a null pointer */
+	if( (NULL != str) && (NULL != word) ){
+		ret_val = (unsigned char*)STRING_search(str, STRING_measure(str), word, STRING_measure(word), 0, STRING_lower_table);
+	}
+	else{ /* Do Nothing */ }
+	return ret_val;
+}
+
+/**=============================================
+  * @Fn				- STRING_memory_search
+  * @brief 			- Returns pointer to first occurrence of the "word_length" bytes of "word" in the "str_length" bytes of "str"
+  * @param [in] 	- str		 : Pointer to the memory to search in
+  * @param [in] 	- str_length : Number of bytes in "str"
+  * @param [in] 	- word		 : Pointer to the bytes to find
+  * @param [in] 	- word_length: Number of bytes in "word"
+  * @param [out] 	- None
+  * @retval 		- Pointer to the first occurrence of "word" in "str"
+  * Note			- Returns NULL if "word" was not found, null bytes are compared like any other byte
+  */
+void* STRING_memory_search(const void* str, size_t str_length, const void* word, size_t word_length){
+	void* ret_val = NULL;
+
+	/* Validate that we are not accessing a null pointer */
+	if( (NULL != str) && (NULL != word) ){
+		ret_val = (void*)STRING_search((const unsigned char*)str, str_length, (const unsigned char*)word, word_length, 0, NULL);
+	}
+	else{ /* Do Nothing */ }
+	return ret_val;
+}
+
+/* Length of a string of any size, STRING_length is limited to 65535 characters */
+static unsigned long STRING_measure(const unsigned char* str){
+	const unsigned char* end = str;
+#if (STRING_WORD_AT_A_TIME == 1)
+	/* Bytes up to the first word boundary, then whole words until one holds the terminating null */
+	while((0 != STRING_WORD_OFFSET(end)) && ('\0' != *end)){
+		end++;
+	}
+	if(0 == STRING_WORD_OFFSET(end)){
+		while(!STRING_WORD_HAS_ZERO(*(const STRING_word*)end)){
+			end += STRING_WORD_SIZE;
+		}
+	}
+	else{ /* Do Nothing */ }
+#endif
+	while('\0' != *end){
+		end++;
+	}
+	return (unsigned long)(end - str);
+}
+
+/* Compares "length" characters through the "fold" table (NULL: as they are), stops at the first difference */
+static unsigned char STRING_equal(const unsigned char* str1, const unsigned char* str2, unsigned long length, const unsigned char* fold){
+	unsigned long index;
+	for(index = 0; index < length; index++){
+		if(STRING_FOLD(fold, str1[index]) != STRING_FOLD(fold, str2[index])){
+			return 0;
+		}
+		else{ /* Do Nothing */ }
+	}
+	return 1;
+}
+
+/*
+ * Finds "word" in the first "str_length" characters of "str", from the start (reverse = 0) or
+ * from the end (reverse = 1). Words of STRING_SEARCH_SKIP_MIN_LENGTH characters or more use
+ * Boyer-Moore-Horspool: the character under the window decides how far the window can jump,
+ * so most positions are never compared. The string callers measure "str" first, which reads all
+ * of it word by word, only STRING_memory_search leaves the skipped characters unread. Building
+ * the skip table doesn't pay off for shorter words, they are compared position by position with
+ * an early exit. Characters sharing a skip entry keep the smallest shift, so no match is jumped.
+ * Characters are compared through the "fold" table, NULL compares them as they are.
+ */
+static const unsigned char* STRING_search(const unsigned char* str, unsigned long str_length, const unsigned char* word, unsigned long word_length, unsigned char reverse, const unsigned char* fold){
+	unsigned char skip[STRING_SEARCH_SKIP_SIZE];
+	unsigned long pos, index, shift;
+
+	if(word_length > str_length){
+		return NULL;
+	}
+	else if(0 == word_length){
+		return (reverse) ? (str + str_length) : str;
+	}
+	else if(word_length < STRING_SEARCH_SKIP_MIN_LENGTH){
+		if(!reverse){
+			for(pos = 0; pos <= (str_length - word_length); pos++){
+				if((STRING_FOLD(fold, str[pos]) == STRING_FOLD(fold, word[0])) && STRING_equal(&str[pos + 1], &word[1], word_length - 1, fold)){
+					return &str[pos];
+				}
+				else{ /* Do Nothing */ }
+			}
+		}
+		else{
+			pos = str_length - word_length + 1;
+			while(pos-- > 0){
+				if((STRING_FOLD(fold, str[pos]) == STRING_FOLD(fold, word[0])) && STRING_equal(&str[pos + 1], &word[1], word_length - 1, fold)){
+					return &str[pos];
 				}
 				else{ /* Do Nothing */ }
 			}
-			if(0 == found_flag){
-				/* If found, set return value and continue to check if there is one more occurence */
-				ret_val = (unsigned char*)&(str[str_index]);
+		}
+		return NULL;
+	}
+	else{ /* Do Nothing */ }
+
+	/* Shifts are capped at 255, a shorter shift never skips a match */
+	shift = (word_length > 255) ? 255 : word_length;
+	for(index = 0; index < STRING_SEARCH_SKIP_SIZE; index++){
+		skip[index] = (unsigned char)shift;
+	}
+
+	if(!reverse){
+		/* Distance from the last occurrence of each character (the last one excluded) to the word end,
+		 * shifts get smaller along the word so a shared entry ends with the smallest */
+		for(index = 0; index < (word_length - 1); index++){
+			shift = word_length - 1 - index;
+			skip[STRING_SKIP(STRING_FOLD(fold, word[index]))] = (unsigned char)((shift > 255) ? 255 : shift);
+		}
+
+		/* Window is str[pos .. pos + word_length - 1], keyed on its last character */
+		pos = 0;
+		while(pos <= (str_length - word_length)){
+			if((STRING_FOLD(fold, str[pos + word_length - 1]) == STRING_FOLD(fold, word[word_length - 1]))
+					&& STRING_equal(&str[pos], word, word_length - 1, fold)){
+				return &str[pos];
+			}
+			else{ /* Do Nothing */ }
+			pos += skip[STRING_SKIP(STRING_FOLD(fold, str[pos + word_length - 1]))];
+		}
+	}
+	else{
+		/* Distance from the word start to the first occurrence of each character (the first one excluded) */
+		index = word_length;
+		while(--index > 0){
+			skip[STRING_SKIP(STRING_FOLD(fold, word[index]))] = (unsigned char)((index > 255) ? 255 : index);
+		}
+
+		/* Same window moving backward, keyed on its first character */
+		pos = str_length - word_length;
+		while(1){
+			if((STRING_FOLD(fold, str[pos]) == STRING_FOLD(fold, word[0])) && STRING_equal(&str[pos + 1], &word[1], word_length - 1, fold)){
+				return &str[pos];
+			}
+			else{ /* Do Nothing */ }
+			shift = skip[STRING_SKIP(STRING_FOLD(fold, str[pos]))];
+			if(pos < shift){
+				break;
+			}
+			else{ /* Do Nothing */ }
+			pos -= shift;
+		}
+	}
+
+	return NULL;
+}
+
+/**=============================================
+  * @Fn				- STRING_memory_copy
+  * @brief 			- Copies "size" bytes from "src" into "des"
+  * @param [in] 	- src : Pointer to the source memory
+  * @param [in] 	- des : Pointer to the destination memory
+  * @param [in] 	- size: Number of bytes to be copied
+  * @param [out] 	- None
+  * @retval 		- Pointer to "des"
+  * Note			- The two areas must not overlap, use STRING_memory_move if they can
+  */
+void* STRING_memory_copy(const void* src, void* des, size_t size){
+	const unsigned char* src_ptr = (const unsigned char*)src;
+	unsigned char* des_ptr = (unsigned char*)des;
+
+	/* Validate that we are not accessing a null pointer */
+	if( (NULL != src) && (NULL != des) ){
+#if (STRING_WORD_AT_A_TIME == 1)
+		/* Bytes up to the destination word boundary */
+		while((0 != size) && (0 != STRING_WORD_OFFSET(des_ptr))){
+			*des_ptr++ = *src_ptr++;
+			size--;
+		}
+
+		if(0 == STRING_WORD_OFFSET(src_ptr)){
+#if defined(__arm__)
+			/* 4 registers loaded and stored per instruction pair */
+			while(size >= (4 * STRING_WORD_SIZE)){
+				__asm volatile ("ldmia %0!, {r3, r4, r5, r6} \n\t"
+								"stmia %1!, {r3, r4, r5, r6}"
+								: "+r" (src_ptr), "+r" (des_ptr) : : "r3", "r4", "r5", "r6", "memory");
+				size -= 4 * STRING_WORD_SIZE;
+			}
+#endif
+			while(size >= STRING_WORD_SIZE){
+				*(STRING_word*)des_ptr = *(const STRING_word*)src_ptr;
+				src_ptr += STRING_WORD_SIZE;
+				des_ptr += STRING_WORD_SIZE;
+				size -= STRING_WORD_SIZE;
+			}
+		}
+#if defined(__ARM_FEATURE_UNALIGNED)
+		else{
+			/* Source is not aligned with the destination, single LDRs can still read it (not LDM) */
+			while(size >= STRING_WORD_SIZE){
+				*(STRING_word*)des_ptr = *(const STRING_unaligned_word*)src_ptr;
+				src_ptr += STRING_WORD_SIZE;
+				des_ptr += STRING_WORD_SIZE;
+				size -= STRING_WORD_SIZE;
+			}
+		}
+#else
+		else{ /* Do Nothing */ }
+#endif
+#endif
+		while(0 != size){
+			*des_ptr++ = *src_ptr++;
+			size--;
+		}
+	}
+	else{ /* Do Nothing */ }
+	return des;
+}
+
+/**=============================================
+  * @Fn				- STRING_memory_move
+  * @brief 			- Copies "size" bytes from "src" into "des", the two areas may overlap
+  * @param [in] 	- src : Pointer to the source memory
+  * @param [in] 	- des : Pointer to the destination memory
+  * @param [in] 	- size: Number of bytes to be copied
+  * @param [out] 	- None
+  * @retval 		- Pointer to "des"
+  * Note			- Copies backward when "des" is inside the source area
+  */
+void* STRING_memory_move(const void* src, void* des, size_t size){
+	const unsigned char* src_ptr = (const unsigned char*)src;
+	unsigned char* des_ptr = (unsigned char*)des;
+
+	/* Validate that we are not accessing a null pointer */
+	if( (NULL != src) && (NULL != des) ){
+		if(((size_t)(des_ptr - src_ptr) >= size)){
+			/* "des" is before "src" or after the source area: a forward copy reads every byte before overwriting it */
+			STRING_memory_copy(src, des, size);
+		}
+		else{
+			/* "des" is inside the source area, copy from the end */
+			src_ptr += size;
+			des_ptr += size;
+#if (STRING_WORD_AT_A_TIME == 1)
+			if(STRING_WORD_OFFSET(src_ptr) == STRING_WORD_OFFSET(des_ptr)){
+				while((0 != size) && (0 != STRING_WORD_OFFSET(des_ptr))){
+					*--des_ptr = *--src_ptr;
+					size--;
+				}
+				while(size >= STRING_WORD_SIZE){
+					src_ptr -= STRING_WORD_SIZE;
+					des_ptr -= STRING_WORD_SIZE;
+					*(STRING_word*)des_ptr = *(const STRING_word*)src_ptr;
+					size -= STRING_WORD_SIZE;
+				}
+			}
+			else{ /* Do Nothing */ }
+#endif
+			while(0 != size){
+				*--des_ptr = *--src_ptr;
+				size--;
+			}
+		}
+	}
+	else{ /* Do Nothing */ }
+	return des;
+}
+
+/**=============================================
+  * @Fn				- STRING_memory_compare
+  * @brief 			- Compares the first "size" bytes of two memory areas
+  * @param [in] 	- ptr1: Pointer to the first memory area
+  * @param [in] 	- ptr2: Pointer to the second memory area
+  * @param [in] 	- size: Number of bytes to be compared
+  * @param [out] 	- None
+  * @retval 		- Returns 0 if the areas are identical. Returns -1 if ptr1 < ptr2. Returns 1 if ptr1 > ptr2
+  * Note			- Bytes are compared as unsigned values, null bytes don't stop the comparison
+  */
+signed char STRING_memory_compare(const void* ptr1, const void* ptr2, size_t size){
+	const unsigned char* ptr1_bytes = (const unsigned char*)ptr1;
+	const unsigned char* ptr2_bytes = (const unsigned char*)ptr2;
+	signed char ret_val = 0;
+
+	/* Validate that we are not accessing a null pointer */
+	if( (NULL != ptr1) && (NULL != ptr2) ){
+#if (STRING_WORD_AT_A_TIME == 1)
+		/* Skip the identical words, the byte loop below finds the difference inside the last one */
+		if(STRING_WORD_OFFSET(ptr1_bytes) == STRING_WORD_OFFSET(ptr2_bytes)){
+			while((0 != size) && (0 != STRING_WORD_OFFSET(ptr1_bytes)) && (*ptr1_bytes == *ptr2_bytes)){
+				ptr1_bytes++;
+				ptr2_bytes++;
+				size--;
+			}
+			if(0 == STRING_WORD_OFFSET(ptr1_bytes)){
+				while((size >= STRING_WORD_SIZE) && (*(const STRING_word*)ptr1_bytes == *(const STRING_word*)ptr2_bytes)){
+					ptr1_bytes += STRING_WORD_SIZE;
+					ptr2_bytes += STRING_WORD_SIZE;
+					size -= STRING_WORD_SIZE;
+				}
+			}
+			else{ /* Do Nothing */ }
+		}
+		else{ /* Do Nothing */ }
+#endif
+		for(; 0 != size; size--){
+			if(*ptr1_bytes != *ptr2_bytes){
+				ret_val = (*ptr1_bytes < *ptr2_bytes) ? -1 : 1;
+				break;
 			}
 			else{ /* Do Nothing */ }
-			str_index++;
+			ptr1_bytes++;
+			ptr2_bytes++;
 		}
 	}
 	else{ /* Do Nothing */ }
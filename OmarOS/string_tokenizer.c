@@ -0,0 +1,337 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : String_Library                                    	 */
+/* File          : string_tokenizer.c                      				 */
+/* Date          : Jun 22, 2023                                          */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+#include "string_tokenizer.h"
+
+/* STRING_stream_tokenizer.State */
+#define STRING_STREAM_FIELD_START	0	/* Nothing received for the current field yet */
+#define STRING_STREAM_UNQUOTED		1
+#define STRING_STREAM_QUOTED		2	/* Inside quotes, delimiters and terminators are data */
+#define STRING_STREAM_QUOTE_SEEN	3	/* A quote inside a quoted field, closing or the first of a doubled one */
+#define STRING_STREAM_AFTER_QUOTE	4	/* Field closed, characters up to the delimiter are ignored */
+#define STRING_STREAM_DISCARD		5	/* Record too long, waiting for its terminator */
+
+static void STRING_stream_emit(STRING_stream_tokenizer* pStream, unsigned char flags);
+
+/**=============================================
+  * @Fn				- STRING_delimiters_init
+  * @brief 			- Fills a delimiters set with the characters of a string
+  * @param [out] 	- pSet		 : Pointer to the set
+  * @param [in] 	- delimiters : Null terminated string of the delimiter characters (",*" for NMEA)
+  * @retval 		- None
+  * Note			- Built once, usually at startup, and shared by any number of tokenizers
+  */
+void STRING_delimiters_init(STRING_delimiters* pSet, const unsigned char* delimiters){
+	/* Validate that we are not accessing a null pointer */
+	if(NULL != pSet){
+		STRING_set_memoryLocation(pSet->Bits, 0, sizeof(pSet->Bits));
+		if(NULL != delimiters){
+			while('\0' != *delimiters){
+				pSet->Bits[*delimiters >> 3] |= (unsigned char)(1U << (*delimiters & 7));
+				delimiters++;
+			}
+		}
+		else{ /* Do Nothing */ }
+	}
+	else{ /* Do Nothing */ }
+}
+
+/**=============================================
+  * @Fn				- STRING_tokenizer_init
+  * @brief 			- Prepares a tokenizer over the "length" characters of "data"
+  * @param [out] 	- pTokenizer : Pointer to the tokenizer
+  * @param [in] 	- data		 : Pointer to one record, without its line ending
+  * @param [in] 	- length	 : Number of characters in "data"
+  * @param [in] 	- pDelimiters: Pointer to the delimiters set
+  * @param [in] 	- quote		 : Character that opens a quoted field ('"' for CSV), 0 if fields are never quoted
+  * @retval 		- None
+  * Note			- An empty buffer has no fields, otherwise N delimiters give N + 1 fields
+  */
+void STRING_tokenizer_init(STRING_tokenizer* pTokenizer, const void* data, size_t length, const STRING_delimiters* pDelimiters, unsigned char quote){
+	/* Validate that we are not accessing a null pointer */
+	if(NULL != pTokenizer){
+		pTokenizer->pData = (const unsigned char*)data;
+		pTokenizer->Length = length;
+		pTokenizer->Position = 0;
+		pTokenizer->pDelimiters = pDelimiters;
+		pTokenizer->Index = 0;
+		pTokenizer->Quote = quote;
+		pTokenizer->Done = ( (NULL == data) || (NULL == pDelimiters) || (0 == length) ) ? 1 : 0;
+	}
+	else{ /* Do Nothing */ }
+}
+
+/**=============================================
+  * @Fn				- STRING_tokenizer_next
+  * @brief 			- Gives the next field of the buffer
+  * @param [in] 	- pTokenizer : Pointer to the tokenizer
+  * @param [out] 	- pField	 : Pointer to the field to be filled
+  * @retval 		- Returns 1 if a field was given, 0 after the last field
+  * Note			- Every character is read once, delimiters inside a quoted field are part of the field
+  */
+unsigned char STRING_tokenizer_next(STRING_tokenizer* pTokenizer, STRING_field* pField){
+	unsigned char ret_val = 0;
+	const unsigned char* data;
+	const STRING_delimiters* pDelimiters;
+	size_t position, length, end;
+
+	/* Validate that we are not accessing a null pointer */
+	if( (NULL != pTokenizer) && (NULL != pField) && (0 == pTokenizer->Done) ){
+		data = pTokenizer->pData;
+		pDelimiters = pTokenizer->pDelimiters;
+		position = pTokenizer->Position;
+		length = pTokenizer->Length;
+		pField->Flags = 0;
+
+		if( (0 != pTokenizer->Quote) && (position < length) && (pTokenizer->Quote == data[position]) ){
+			/* Quoted field: up to the closing quote, a doubled quote is part of the field */
+			position++;
+			pField->Offset = position;
+			pField->Flags = STRING_FIELD_QUOTED;
+			while(position < length){
+				if(pTokenizer->Quote != data[position]){
+					position++;
+				}
+				else if( ((position + 1) < length) && (pTokenizer->Quote == data[position + 1]) ){
+					position += 2;
+				}
+				else{
+					break;
+				}
+			}
+			end = position;
+		}
+		else{
+			pField->Offset = position;
+			end = 0;
+		}
+
+		/* Up to the delimiter, anything between a closing quote and the delimiter is dropped */
+		while( (position < length) && !STRING_DELIMITERS_HAS(pDelimiters, data[position]) ){
+			position++;
+		}
+		if(0 == (pField->Flags & STRING_FIELD_QUOTED)){
+			end = position;
+		}
+		else{ /* Do Nothing */ }
+
+		pField->Length = end - pField->Offset;
+		pField->Index = pTokenizer->Index++;
+
+		/* Step over the delimiter, a delimiter at the very end is followed by an empty field */
+		if(position < length){
+			pTokenizer->Position = position + 1;
+		}
+		else{
+			pTokenizer->Position = length;
+			pTokenizer->Done = 1;
+			pField->Flags |= STRING_FIELD_LAST;
+		}
+		ret_val = 1;
+	}
+	else{ /* Do Nothing */ }
+	return ret_val;
+}
+
+/**=============================================
+  * @Fn				- STRING_field_view
+  * @brief 			- Returns a view of a field
+  * @param [in] 	- base	: Pointer to the buffer (record) the field was found in
+  * @param [in] 	- pField: Pointer to the field
+  * @param [out] 	- None
+  * @retval 		- The view
+  * Note			- None
+  */
+STRING_view STRING_field_view(const void* base, const STRING_field* pField){
+	STRING_view view = { NULL, 0 };
+
+	/* Validate that we are not accessing a null pointer */
+	if( (NULL != base) && (NULL != pField) ){
+		view = STRING_view_make((const unsigned char*)base + pField->Offset, pField->Length);
+	}
+	else{ /* Do Nothing */ }
+	return view;
+}
+
+/**=============================================
+  * @Fn				- STRING_stream_init
+  * @brief 			- Prepares a tokenizer that is fed with STRING_stream_push
+  * @param [out] 	- pStream	  : Pointer to the tokenizer
+  * @param [in] 	- storage	  : Pointer to the memory holding the current record
+  * @param [in] 	- capacity	  : Bytes in "storage", longer records are dropped (see STRING_stream_push)
+  * @param [in] 	- pDelimiters : Pointer to the delimiters set
+  * @param [in] 	- pTerminators: Pointer to the set of characters ending a record ("\r\n")
+  * @param [in] 	- quote		  : Character that opens a quoted field, 0 if fields are never quoted
+  * @param [in] 	- pfCallback  : Function called for every field
+  * @param [in] 	- pContext	  : Passed to "pfCallback" as it is
+  * @retval 		- None
+  * Note			- Empty records ("\r\n" line endings) are skipped
+  */
+void STRING_stream_init(STRING_stream_tokenizer* pStream, unsigned char* storage, size_t capacity, const STRING_delimiters* pDelimiters,
+		const STRING_delimiters* pTerminators, unsigned char quote, STRING_field_callback pfCallback, void* pContext){
+	/* Validate that we are not accessing a null pointer */
+	if(NULL != pStream){
+		pStream->pRecord = storage;
+		pStream->Capacity = (NULL != storage) ? capacity : 0;
+		pStream->pDelimiters = pDelimiters;
+		pStream->pTerminators = pTerminators;
+		pStream->Quote = quote;
+		pStream->pfCallback = pfCallback;
+		pStream->pContext = pContext;
+		pStream->Overflows = 0;
+		STRING_stream_reset(pStream);
+	}
+	else{ /* Do Nothing */ }
+}
+
+/**=============================================
+  * @Fn				- STRING_stream_push
+  * @brief 			- Tokenizes the next "length" received characters
+  * @param [in] 	- pStream: Pointer to the tokenizer
+  * @param [in] 	- data	 : Pointer to the received characters
+  * @param [in] 	- length : Number of characters in "data"
+  * @param [out] 	- None
+  * @retval 		- None
+  * Note			- A field is given as soon as its delimiter arrives, records and quoted fields can be split over any
+  * 				  number of pushes. A ring buffer is pushed as its two contiguous parts
+  * 				  When a record outgrows the storage its fields given so far are followed by an empty field flagged
+  * 				  STRING_FIELD_ABORTED | STRING_FIELD_LAST, the rest of the record is dropped and counted in Overflows
+  */
+void STRING_stream_push(STRING_stream_tokenizer* pStream, const void* data, size_t length){
+	const unsigned char* bytes = (const unsigned char*)data;
+	unsigned char character;
+
+	/* Validate that we are not accessing a null pointer */
+	if( (NULL != pStream) && (NULL != bytes) && (NULL != pStream->pDelimiters) && (NULL != pStream->pTerminators) ){
+		for(; 0 != length; length--){
+			character = *bytes++;
+
+			/* Quotes are checked before the sets, a closed quoted field continues like an unquoted one */
+			if(STRING_STREAM_QUOTE_SEEN == pStream->State){
+				if(pStream->Quote == character){
+					pStream->State = STRING_STREAM_QUOTED;
+				}
+				else{
+					pStream->FieldEnd = pStream->Length - 1;
+					pStream->State = STRING_STREAM_AFTER_QUOTE;
+				}
+			}
+			else if(STRING_STREAM_QUOTED == pStream->State){
+				if(pStream->Quote == character){
+					pStream->State = STRING_STREAM_QUOTE_SEEN;
+				}
+				else{ /* Do Nothing */ }
+			}
+			else if( (STRING_STREAM_FIELD_START == pStream->State) && (0 != pStream->Quote) && (pStream->Quote == character) ){
+				pStream->FieldStart = pStream->Length + 1;
+				pStream->Flags = STRING_FIELD_QUOTED;
+				pStream->State = STRING_STREAM_QUOTED;
+			}
+			else{ /* Do Nothing */ }
+
+			if( (STRING_STREAM_QUOTED == pStream->State) || (STRING_STREAM_QUOTE_SEEN == pStream->State) ){
+				/* Stored below like any other field character */
+			}
+			else if(STRING_DELIMITERS_HAS(pStream->pTerminators, character)){
+				if(STRING_STREAM_DISCARD == pStream->State){
+					STRING_stream_reset(pStream);
+				}
+				else if( (0 == pStream->Length) && (0 == pStream->Index) ){
+					/* Empty record, the second half of "\r\n" */
+				}
+				else{
+					STRING_stream_emit(pStream, STRING_FIELD_LAST);
+					STRING_stream_reset(pStream);
+				}
+				continue;
+			}
+			else if(STRING_STREAM_DISCARD == pStream->State){
+				continue;
+			}
+			else if(STRING_DELIMITERS_HAS(pStream->pDelimiters, character)){
+				STRING_stream_emit(pStream, 0);
+			}
+			else if(STRING_STREAM_FIELD_START == pStream->State){
+				pStream->FieldStart = pStream->Length;
+				pStream->State = STRING_STREAM_UNQUOTED;
+			}
+			else{ /* Do Nothing */ }
+
+			/* The record is kept as received, delimiters and quotes included */
+			if(pStream->Length < pStream->Capacity){
+				pStream->pRecord[pStream->Length++] = character;
+			}
+			else{
+				pStream->Overflows++;
+				if(0 != pStream->Index){
+					/* Fields of this record were already given, an empty aborted last field tells the callback to drop them */
+					pStream->Flags = 0;
+					pStream->State = STRING_STREAM_FIELD_START;
+					STRING_stream_emit(pStream, STRING_FIELD_ABORTED | STRING_FIELD_LAST);
+				}
+				else{ /* Do Nothing */ }
+				pStream->State = STRING_STREAM_DISCARD;
+			}
+		}
+	}
+	else{ /* Do Nothing */ }
+}
+
+/**=============================================
+  * @Fn				- STRING_stream_reset
+  * @brief 			- Drops the record received so far
+  * @param [in] 	- pStream: Pointer to the tokenizer
+  * @param [out] 	- None
+  * @retval 		- None
+  * Note			- Used after a receive error, the next pushed character starts a new record
+  */
+void STRING_stream_reset(STRING_stream_tokenizer* pStream){
+	/* Validate that we are not accessing a null pointer */
+	if(NULL != pStream){
+		pStream->Length = 0;
+		pStream->FieldStart = 0;
+		pStream->FieldEnd = 0;
+		pStream->Index = 0;
+		pStream->Flags = 0;
+		pStream->State = STRING_STREAM_FIELD_START;
+	}
+	else{ /* Do Nothing */ }
+}
+
+/* Gives the field ending at the current character (a delimiter or a terminator) to the callback */
+static void STRING_stream_emit(STRING_stream_tokenizer* pStream, unsigned char flags){
+	STRING_field field;
+
+	switch(pStream->State){
+	case STRING_STREAM_FIELD_START:
+		/* Nothing between two delimiters */
+		field.Offset = pStream->Length;
+		field.Length = 0;
+		break;
+	case STRING_STREAM_AFTER_QUOTE:
+		/* Ended at the closing quote */
+		field.Offset = pStream->FieldStart;
+		field.Length = pStream->FieldEnd - pStream->FieldStart;
+		break;
+	default:
+		field.Offset = pStream->FieldStart;
+		field.Length = pStream->Length - pStream->FieldStart;
+		break;
+	}
+	field.Index = pStream->Index++;
+	field.Flags = pStream->Flags | flags;
+
+	if(NULL != pStream->pfCallback){
+		pStream->pfCallback(pStream->pContext, pStream->pRecord, &field);
+	}
+	else{ /* Do Nothing */ }
+
+	pStream->Flags = 0;
+	pStream->State = STRING_STREAM_FIELD_START;
+}
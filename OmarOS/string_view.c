@@ -0,0 +1,339 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : String_Library                                    	 */
+/* File          : string_view.c                           				 */
+/* Date          : Jun 22, 2023                                          */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+#include "string_view.h"
+
+/**=============================================
+  * @Fn				- STRING_view_make
+  * @brief 			- Makes a view of "length" characters starting at "data"
+  * @param [in] 	- data  : Pointer to the first character
+  * @param [in] 	- length: Number of characters
+  * @param [out] 	- None
+  * @retval 		- The view
+  * Note			- None
+  */
+STRING_view STRING_view_make(const void* data, size_t length){
+	STRING_view view;
+	view.pData = (const unsigned char*)data;
+	view.Length = (NULL != data) ? length : 0;
+	return view;
+}
+
+/**=============================================
+  * @Fn				- STRING_view_fromString
+  * @brief 			- Makes a view of a null terminated string
+  * @param [in] 	- str: Pointer to the string
+  * @param [out] 	- None
+  * @retval 		- The view, empty if "str" is NULL
+  * Note			- The only view operation that scans for the terminating null
+  */
+STRING_view STRING_view_fromString(const unsigned char* str){
+	STRING_view view;
+	view.pData = str;
+	view.Length = 0;
+
+	/* Validate that we are not accessing a null pointer */
+	if(NULL != str){
+		/* Measured once here, every operation on the view uses the length */
+		while('\0' != str[view.Length]){
+			view.Length++;
+		}
+	}
+	else{ /* Do Nothing */ }
+	return view;
+}
+
+/**=============================================
+  * @Fn				- STRING_view_sub
+  * @brief 			- Makes a view of part of another view
+  * @param [in] 	- view  : The whole view
+  * @param [in] 	- start : Index of the first character
+  * @param [in] 	- length: Number of characters, cut at the end of "view"
+  * @param [out] 	- None
+  * @retval 		- The view, empty if "start" is past the end of "view"
+  * Note			- None
+  */
+STRING_view STRING_view_sub(STRING_view view, size_t start, size_t length){
+	STRING_view sub;
+	if(start < view.Length){
+		sub.pData = view.pData + start;
+		sub.Length = ((view.Length - start) < length) ? (view.Length - start) : length;
+	}
+	else{
+		sub.pData = view.pData + view.Length;
+		sub.Length = 0;
+	}
+	return sub;
+}
+
+/**=============================================
+  * @Fn				- STRING_view_compare
+  * @brief 			- Compares two views (case sensitive)
+  * @param [in] 	- view1: The first view
+  * @param [in] 	- view2: The second view
+  * @param [out] 	- None
+  * @retval 		- Returns 0 if view1 is same as view2. Returns -1 if view1 < view2. Returns 1 if view1 > view2
+  * Note			- A view that is the start of the other one is the smaller
+  */
+signed char STRING_view_compare(STRING_view view1, STRING_view view2){
+	size_t common = (view1.Length < view2.Length) ? view1.Length : view2.Length;
+	signed char ret_val = STRING_memory_compare(view1.pData, view2.pData, common);
+
+	/* Same characters up to the end of the shorter view, the shorter one comes first */
+	if(0 == ret_val){
+		if(view1.Length < view2.Length){
+			ret_val = -1;
+		}
+		else if(view1.Length > view2.Length){
+			ret_val = 1;
+		}
+		else{ /* Do Nothing */ }
+	}
+	else{ /* Do Nothing */ }
+	return ret_val;
+}
+
+/**=============================================
+  * @Fn				- STRING_view_equal_caseInsensitive
+  * @brief 			- Checks if two views hold the same characters ignoring the letters case
+  * @param [in] 	- view1: The first view
+  * @param [in] 	- view2: The second view
+  * @param [out] 	- None
+  * @retval 		- Returns 1 if the views are equal, 0 otherwise
+  * Note			- None
+  */
+unsigned char STRING_view_equal_caseInsensitive(STRING_view view1, STRING_view view2){
+	unsigned char ret_val = 0;
+	size_t index;
+
+	/* Views of different lengths can't be equal, nothing to read */
+	if(view1.Length == view2.Length){
+		ret_val = 1;
+		for(index = 0; index < view1.Length; index++){
+			/* Folded through the string_lib table, one load per character instead of two compares */
+			if(STRING_lower_table[view1.pData[index]] != STRING_lower_table[view2.pData[index]]){
+				ret_val = 0;
+				break;
+			}
+			else{ /* Do Nothing */ }
+		}
+	}
+	else{ /* Do Nothing */ }
+	return ret_val;
+}
+
+/**=============================================
+  * @Fn				- STRING_view_startsWith
+  * @brief 			- Checks if "view" starts with "prefix"
+  * @param [in] 	- view  : The view to check
+  * @param [in] 	- prefix: The expected start
+  * @param [out] 	- None
+  * @retval 		- Returns 1 if "view" starts with "prefix", 0 otherwise
+  * Note			- None
+  */
+unsigned char STRING_view_startsWith(STRING_view view, STRING_view prefix){
+	unsigned char ret_val = 0;
+	if( (prefix.Length <= view.Length) && (0 == STRING_memory_compare(view.pData, prefix.pData, prefix.Length)) ){
+		ret_val = 1;
+	}
+	else{ /* Do Nothing */ }
+	return ret_val;
+}
+
+/**=============================================
+  * @Fn				- STRING_view_find
+  * @brief 			- Returns the index of the first occurrence of "word" in "view"
+  * @param [in] 	- view: The view to search in
+  * @param [in] 	- word: The characters to find
+  * @param [out] 	- None
+  * @retval 		- Index of the first occurrence, STRING_VIEW_NPOS if "word" was not found
+  * Note			- Boyer-Moore-Horspool search (STRING_memory_search), the view is not scanned for its length
+  */
+size_t STRING_view_find(STRING_view view, STRING_view word){
+	size_t ret_val = STRING_VIEW_NPOS;
+	const unsigned char* found = (const unsigned char*)STRING_memory_search(view.pData, view.Length, word.pData, word.Length);
+	if(NULL != found){
+		ret_val = (size_t)(found - view.pData);
+	}
+	else{ /* Do Nothing */ }
+	return ret_val;
+}
+
+/**=============================================
+  * @Fn				- STRING_view_split
+  * @brief 			- Takes the next token, up to "delimiter", from the start of a view
+  * @param [in] 	- pRest	   : Pointer to the view to split, moved past the token and its delimiter
+  * @param [in] 	- delimiter: Character that ends a token
+  * @param [out] 	- pToken   : Pointer to the view to receive the token, without the delimiter
+  * @retval 		- Returns 1 if a token was taken, 0 if "pRest" was already empty
+  * Note			- Two delimiters in a row give an empty token, each call only reads the token it returns
+  */
+unsigned char STRING_view_split(STRING_view* pRest, unsigned char delimiter, STRING_view* pToken){
+	unsigned char ret_val = 0;
+	size_t index;
+
+	/* Validate that we are not accessing a null pointer */
+	if( (NULL != pRest) && (NULL != pToken) && (NULL != pRest->pData) && (0 != pRest->Length) ){
+		for(index = 0; (index < pRest->Length) && (delimiter != pRest->pData[index]); index++);
+
+		pToken->pData = pRest->pData;
+		pToken->Length = index;
+
+		/* Step over the delimiter, if the token ended on one */
+		if(index < pRest->Length){
+			index++;
+		}
+		else{ /* Do Nothing */ }
+		pRest->pData += index;
+		pRest->Length -= index;
+		ret_val = 1;
+	}
+	else{ /* Do Nothing */ }
+	return ret_val;
+}
+
+/**=============================================
+  * @Fn				- STRING_buffer_init
+  * @brief 			- Prepares an empty buffer over "storage"
+  * @param [out] 	- pBuffer : Pointer to the buffer
+  * @param [in] 	- storage : Pointer to the memory used by the buffer
+  * @param [in] 	- capacity: Bytes in "storage", the terminating null included (at least 1)
+  * @retval 		- None
+  * Note			- None
+  */
+void STRING_buffer_init(STRING_buffer* pBuffer, unsigned char* storage, size_t capacity){
+	/* Validate that we are not accessing a null pointer */
+	if(NULL != pBuffer){
+		pBuffer->pData = storage;
+		pBuffer->Capacity = (NULL != storage) ? capacity : 0;
+		STRING_buffer_clear(pBuffer);
+	}
+	else{ /* Do Nothing */ }
+}
+
+/**=============================================
+  * @Fn				- STRING_buffer_clear
+  * @brief 			- Empties a buffer so it can be reused
+  * @param [in] 	- pBuffer: Pointer to the buffer
+  * @param [out] 	- None
+  * @retval 		- None
+  * Note			- None
+  */
+void STRING_buffer_clear(STRING_buffer* pBuffer){
+	/* Validate that we are not accessing a null pointer */
+	if(NULL != pBuffer){
+		pBuffer->Length = 0;
+		pBuffer->Truncated = 0;
+		if(0 != pBuffer->Capacity){
+			pBuffer->pData[0] = '\0';
+		}
+		else{ /* Do Nothing */ }
+	}
+	else{ /* Do Nothing */ }
+}
+
+/**=============================================
+  * @Fn				- STRING_buffer_append
+  * @brief 			- Appends the characters of a view at the end of a buffer
+  * @param [in] 	- pBuffer: Pointer to the buffer
+  * @param [in] 	- view	 : Characters to be appended
+  * @param [out] 	- None
+  * @retval 		- Returns 1 if everything was appended, 0 if the buffer was full (the start that fits is appended)
+  * Note			- Constant time to find the end, the buffer stays null terminated
+  */
+unsigned char STRING_buffer_append(STRING_buffer* pBuffer, STRING_view view){
+	unsigned char ret_val = 0;
+	size_t room;
+
+	/* Validate that we are not accessing a null pointer */
+	if( (NULL != pBuffer) && (0 != pBuffer->Capacity) ){
+		/* The end is pBuffer->Length, one byte is always kept for the terminating null */
+		room = pBuffer->Capacity - 1 - pBuffer->Length;
+		if(view.Length <= room){
+			room = view.Length;
+			ret_val = 1;
+		}
+		else{
+			pBuffer->Truncated = 1;
+		}
+		STRING_memory_copy(view.pData, pBuffer->pData + pBuffer->Length, room);
+		pBuffer->Length += room;
+		pBuffer->pData[pBuffer->Length] = '\0';
+	}
+	else{ /* Do Nothing */ }
+	return ret_val;
+}
+
+/**=============================================
+  * @Fn				- STRING_buffer_append_string
+  * @brief 			- Appends a null terminated string at the end of a buffer
+  * @param [in] 	- pBuffer: Pointer to the buffer
+  * @param [in] 	- str	 : Pointer to the string to be appended
+  * @param [out] 	- None
+  * @retval 		- Returns 1 if everything was appended, 0 if the buffer was full
+  * Note			- Only "str" is scanned, not the buffer
+  */
+unsigned char STRING_buffer_append_string(STRING_buffer* pBuffer, const unsigned char* str){
+	return STRING_buffer_append(pBuffer, STRING_view_fromString(str));
+}
+
+/**=============================================
+  * @Fn				- STRING_buffer_append_char
+  * @brief 			- Appends one character at the end of a buffer
+  * @param [in] 	- pBuffer  : Pointer to the buffer
+  * @param [in] 	- character: Character to be appended
+  * @param [out] 	- None
+  * @retval 		- Returns 1 if the character was appended, 0 if the buffer was full
+  * Note			- None
+  */
+unsigned char STRING_buffer_append_char(STRING_buffer* pBuffer, unsigned char character){
+	return STRING_buffer_append(pBuffer, STRING_view_make(&character, 1));
+}
+
+/**=============================================
+  * @Fn				- STRING_buffer_append_unsigned
+  * @brief 			- Appends the decimal digits of "value" at the end of a buffer
+  * @param [in] 	- pBuffer: Pointer to the buffer
+  * @param [in] 	- value	 : Number to be appended
+  * @param [out] 	- None
+  * @retval 		- Returns 1 if every digit was appended, 0 if the buffer was full
+  * Note			- None
+  */
+unsigned char STRING_buffer_append_unsigned(STRING_buffer* pBuffer, unsigned long value){
+	/* Enough digits for a 64 bits value, filled from the end */
+	unsigned char digits[20];
+	size_t index = sizeof(digits);
+
+	do{
+		digits[--index] = (unsigned char)('0' + (value % 10));
+		value /= 10;
+	}while(0 != value);
+
+	return STRING_buffer_append(pBuffer, STRING_view_make(&digits[index], sizeof(digits) - index));
+}
+
+/**=============================================
+  * @Fn				- STRING_buffer_view
+  * @brief 			- Returns a view of the characters in a buffer
+  * @param [in] 	- pBuffer: Pointer to the buffer
+  * @param [out] 	- None
+  * @retval 		- The view, valid until the buffer is changed
+  * Note			- None
+  */
+STRING_view STRING_buffer_view(const STRING_buffer* pBuffer){
+	STRING_view view = { NULL, 0 };
+
+	/* Validate that we are not accessing a null pointer */
+	if(NULL != pBuffer){
+		view.pData = pBuffer->pData;
+		view.Length = pBuffer->Length;
+	}
+	else{ /* Do Nothing */ }
+	return view;
+}
@@ -8,10 +8,10 @@
 /*************************************************************************/
 
 #include "scheduler.h"
+#include "OmarOS_StaticTasks.h"
 
-Task_ref Task1, Task2, Task3, Task4;
 uint8	 Task1LED, Task2LED, Task3LED, Task4LED;
-Mutex_ref MUTEX1;
+Mutex_ref MUTEX1 = { OMAROS_MUTEX_NAME("Mutex Shared T1_T4") };
 
 uint8 array[3] = {1,2,3};
 
@@ -23,6 +23,16 @@ void Task_3(void);
 
 void Task_4(void);
 
+/* TASK(name, entry, priority, stack_size, autostart)
+ * TASK_EX(name, entry, priority, stack_size, autostart, time_slice, deadline, budget, period, heap_quota) */
+#define APP_TASKS(TASK, TASK_EX)												\
+	TASK_EX(Task1, Task_1, 10, 1024, Autostart_Enabled, 2, 20, 0, 0, 0)		\
+	TASK_EX(Task2, Task_2,  8, 1024, Autostart_Disabled, 0, 10, 4, 20, 256)	\
+	TASK(Task3, Task_3,  1, 1024, Autostart_Disabled)							\
+	TASK(Task4, Task_4,  3, 1024, Autostart_Disabled)
+
+OMAROS_STATIC_TASKS_DEFINE(APP_TASKS)
+
 int main(void)
 {
 	OmarOS_errorTypes retval = noError;
@@ -30,40 +40,14 @@ int main(void)
 	HW_Init();
 	retval |= OmarOS_Init();
 
-	Task1.Stack_Size = 1024;
-	Task1.pf_TaskEntry = Task_1;
-	Task1.Priority = 10;
-	Task1.AutoStart = Autostart_Enabled;
-	STRING_copy((uint8*)"Task_1", (uint8*)&Task1.TaskName);
-
-	Task2.Stack_Size = 1024;
-	Task2.pf_TaskEntry = Task_2;
-	Task2.Priority = 8;
-	Task2.AutoStart = Autostart_Disabled;
-	STRING_copy((uint8*)"Task_2", (uint8*)&Task2.TaskName);
-
-	Task3.Stack_Size = 1024;
-	Task3.pf_TaskEntry = Task_3;
-	Task3.Priority = 1;
-	Task3.AutoStart = Autostart_Disabled;
-	STRING_copy((uint8*)"Task_3", (uint8*)&Task3.TaskName);
-
-	Task4.Stack_Size = 1024;
-	Task4.pf_TaskEntry = Task_4;
-	Task4.Priority = 3;
-	Task4.AutoStart = Autostart_Disabled;
-	STRING_copy((uint8*)"Task_4", (uint8*)&Task4.TaskName);
-
-	retval |= OmarOS_CreateTask(&Task1);
-	retval |= OmarOS_CreateTask(&Task2);
-	retval |= OmarOS_CreateTask(&Task3);
-	retval |= OmarOS_CreateTask(&Task4);
+	/* Tasks and their stacks are laid out at build time, only the table is walked here */
+	retval |= OMAROS_REGISTER_STATIC_TASKS();
 
 	MUTEX1.PayloadSize = 3;
 	MUTEX1.pPayload = array;
 	MUTEX1.PriorityCeiling.state = PriorityCeiling_disabled;
 	MUTEX1.PriorityCeiling.Ceiling_Priority = 2;
-	STRING_copy((uint8*)"Mutex Shared T1_T4", (uint8*)&MUTEX1.MutexName);
+	OmarOS_RegisterMutex(&MUTEX1);
 
 	OmarOS_StartOS();
 
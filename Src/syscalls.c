@@ -29,6 +29,10 @@
 #include <time.h>
 #include <sys/time.h>
 #include <sys/times.h>
+#include "OmarOSConfig.h"
+#if (OMAROS_USE_CONSOLE == 1)
+#include "OmarOS_Console.h"
+#endif
 
 
 /* Variables */
@@ -80,6 +84,10 @@ __attribute__((weak)) int _read(int file, char *ptr, int len)
 __attribute__((weak)) int _write(int file, char *ptr, int len)
 {
   (void)file;
+#if (OMAROS_USE_CONSOLE == 1)
+  /* Buffered, sent by the console task */
+  return OmarOS_ConsoleWrite(ptr, len);
+#else
   int DataIdx;
 
   for (DataIdx = 0; DataIdx < len; DataIdx++)
@@ -87,6 +95,7 @@ __attribute__((weak)) int _write(int file, char *ptr, int len)
     __io_putchar(*ptr++);
   }
   return len;
+#endif
 }
 
 int _close(int file)
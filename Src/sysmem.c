@@ -2,7 +2,8 @@
  ******************************************************************************
  * @file      sysmem.c
  * @author    Generated by STM32CubeIDE
- * @brief     STM32CubeIDE System Memory calls file
+ * @brief     STM32CubeIDE System Memory calls file, adapted to route the
+ *            newlib malloc family to the OmarOS heap
  *
  *            For more information about which C functions
  *            need which of these lowlevel functions
@@ -23,57 +24,294 @@
 /* Includes */
 #include <errno.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <malloc.h>
+#include <reent.h>
+#include "OmarOS_Heap.h"
 
 /**
- * Pointer to the current high watermark of the heap usage
+ * Alignment of valloc and pvalloc, newlib's MALLOC_PAGE_ALIGN
  */
-static uint8_t *__sbrk_heap_end = NULL;
+#define SYSMEM_PAGE_SIZE 0x1000U
 
 /**
- * @brief _sbrk() allocates memory to the newlib heap and is used by malloc
- *        and others from the C library
+ * Set once the OmarOS heap owns the region between '_end' and '_eheap'
+ */
+static uint8_t __heap_initialized = 0;
+
+/**
+ * @brief _sbrk() used to grow the newlib heap, the region is now managed by
+ *        the OmarOS TLSF heap so the break can't be moved anymore
  *
  * @verbatim
  * ############################################################################
- * #  .data  #  .bss  #       newlib heap       #          MSP stack          #
- * #         #        #                         # Reserved by _Min_Stack_Size #
+ * #  .data  #  .bss  #       OmarOS heap       #    Task stacks   # MSP stack #
+ * #         #        #                         #    (PSP area)    #           #
  * ############################################################################
- * ^-- RAM start      ^-- _end                             _estack, RAM end --^
+ * ^-- RAM start      ^-- _end           _eheap --^        _estack, RAM end --^
  * @endverbatim
  *
- * This implementation starts allocating at the '_end' linker symbol
- * The '_Min_Stack_Size' linker symbol reserves a memory for the MSP stack
- * The implementation considers '_estack' linker symbol to be RAM end
- * NOTE: If the MSP stack, at any point during execution, grows larger than the
- * reserved size, please increase the '_Min_Stack_Size'.
- *
  * @param incr Memory size
- * @return Pointer to allocated memory
+ * @return Always (void *)-1 with errno set to ENOMEM
  */
 void *_sbrk(ptrdiff_t incr)
+{
+  (void)incr;
+  errno = ENOMEM;
+  return (void *)-1;
+}
+
+/**
+ * @brief Hands the region between '_end' and '_eheap' to the OmarOS heap
+ *        the first time the C library allocates memory
+ */
+static void __heap_init(void)
 {
   extern uint8_t _end; /* Symbol defined in the linker script */
-  extern uint8_t _estack; /* Symbol defined in the linker script */
-  extern uint32_t _Min_Stack_Size; /* Symbol defined in the linker script */
-  const uint32_t stack_limit = (uint32_t)&_estack - (uint32_t)&_Min_Stack_Size;
-  const uint8_t *max_heap = (uint8_t *)stack_limit;
-  uint8_t *prev_heap_end;
-
-  /* Initialize heap end at first call */
-  if (NULL == __sbrk_heap_end)
+
+  OmarOS_SuspendScheduler();
+  if (0 == __heap_initialized)
+  {
+    OmarOS_HeapInit(&_end, (uint32_t)&_eheap - (uint32_t)&_end);
+    __heap_initialized = 1;
+  }
+  OmarOS_ResumeScheduler();
+}
+
+/**
+ * @brief newlib calls these around its allocator internals, map them to the
+ *        OmarOS scheduler lock so the C library heap is safe across tasks
+ */
+void __malloc_lock(struct _reent *r)
+{
+  (void)r;
+  OmarOS_SuspendScheduler();
+}
+
+void __malloc_unlock(struct _reent *r)
+{
+  (void)r;
+  OmarOS_ResumeScheduler();
+}
+
+/**
+ * @brief Reentrant malloc family used by newlib, routed to the OmarOS heap
+ *        which gives constant time allocate/free
+ */
+void *_malloc_r(struct _reent *r, size_t size)
+{
+  void *ptr;
+
+  if (0 == __heap_initialized)
+  {
+    __heap_init();
+  }
+
+  __malloc_lock(r);
+  ptr = OmarOS_HeapAlloc(size);
+  __malloc_unlock(r);
+
+  if ((NULL == ptr) && (0 != size))
+  {
+    errno = ENOMEM;
+  }
+  return ptr;
+}
+
+void _free_r(struct _reent *r, void *ptr)
+{
+  __malloc_lock(r);
+  OmarOS_HeapFree(ptr);
+  __malloc_unlock(r);
+}
+
+void *_realloc_r(struct _reent *r, void *ptr, size_t size)
+{
+  void *new_ptr;
+
+  if (NULL == ptr)
   {
-    __sbrk_heap_end = &_end;
+    return _malloc_r(r, size);
   }
 
-  /* Protect heap from growing into the reserved MSP stack */
-  if (__sbrk_heap_end + incr > max_heap)
+  __malloc_lock(r);
+  new_ptr = OmarOS_HeapRealloc(ptr, size);
+  __malloc_unlock(r);
+
+  if ((NULL == new_ptr) && (0 != size))
   {
     errno = ENOMEM;
-    return (void *)-1;
   }
+  return new_ptr;
+}
+
+void *_calloc_r(struct _reent *r, size_t nmemb, size_t size)
+{
+  uint8_t *ptr;
+  size_t total = nmemb * size;
+  size_t index;
 
-  prev_heap_end = __sbrk_heap_end;
-  __sbrk_heap_end += incr;
+  /* Multiplication overflow */
+  if ((0 != size) && ((total / size) != nmemb))
+  {
+    errno = ENOMEM;
+    return NULL;
+  }
 
-  return (void *)prev_heap_end;
+  ptr = _malloc_r(r, total);
+  if (NULL != ptr)
+  {
+    for (index = 0; index < total; index++)
+    {
+      ptr[index] = 0;
+    }
+  }
+  return ptr;
+}
+
+/**
+ * @brief The rest of the newlib-nano allocator API. Each of these lives in an
+ *        object of libc.a that reads the nano allocator's own chunk headers and
+ *        free list, they are overridden so none of them is linked.
+ *        aligned_alloc and posix_memalign call memalign and come here too
+ */
+void *_memalign_r(struct _reent *r, size_t align, size_t size)
+{
+  void *ptr;
+
+  if (0 == __heap_initialized)
+  {
+    __heap_init();
+  }
+
+  __malloc_lock(r);
+  ptr = OmarOS_HeapAllocAligned(align, size);
+  __malloc_unlock(r);
+
+  if ((NULL == ptr) && (0 != size))
+  {
+    errno = ENOMEM;
+  }
+  return ptr;
+}
+
+void *_valloc_r(struct _reent *r, size_t size)
+{
+  return _memalign_r(r, SYSMEM_PAGE_SIZE, size);
+}
+
+void *_pvalloc_r(struct _reent *r, size_t size)
+{
+  return _memalign_r(r, SYSMEM_PAGE_SIZE, (size + SYSMEM_PAGE_SIZE - 1) & ~(SYSMEM_PAGE_SIZE - 1));
+}
+
+size_t _malloc_usable_size_r(struct _reent *r, void *ptr)
+{
+  size_t size;
+
+  __malloc_lock(r);
+  size = OmarOS_HeapUsableSize(ptr);
+  __malloc_unlock(r);
+
+  return size;
+}
+
+struct mallinfo _mallinfo_r(struct _reent *r)
+{
+  struct mallinfo info = { 0 };
+  Heap_stats stats;
+
+  (void)r;
+  OmarOS_HeapGetStats(&stats);
+  info.arena = stats.TotalSize;
+  info.ordblks = stats.NoOfFreeBlocks;
+  info.uordblks = stats.TotalSize - stats.FreeSize;
+  info.fordblks = stats.FreeSize;
+  return info;
+}
+
+void _malloc_stats_r(struct _reent *r)
+{
+  struct mallinfo info = _mallinfo_r(r);
+
+  fprintf(stderr, "max system bytes = %10u\n", (unsigned int)info.arena);
+  fprintf(stderr, "system bytes     = %10u\n", (unsigned int)info.arena);
+  fprintf(stderr, "in use bytes     = %10u\n", (unsigned int)info.uordblks);
+}
+
+/* The OmarOS heap never takes memory from the break, there is nothing to give back */
+int _malloc_trim_r(struct _reent *r, size_t pad)
+{
+  (void)r;
+  (void)pad;
+  return 0;
+}
+
+/* No tunable parameter in the OmarOS heap, every option is refused */
+int _mallopt_r(struct _reent *r, int param, int value)
+{
+  (void)r;
+  (void)param;
+  (void)value;
+  return 0;
+}
+
+void *malloc(size_t size)
+{
+  return _malloc_r(NULL, size);
+}
+
+void free(void *ptr)
+{
+  _free_r(NULL, ptr);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+  return _realloc_r(NULL, ptr, size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+  return _calloc_r(NULL, nmemb, size);
+}
+
+void *memalign(size_t align, size_t size)
+{
+  return _memalign_r(NULL, align, size);
+}
+
+void *valloc(size_t size)
+{
+  return _valloc_r(NULL, size);
+}
+
+void *pvalloc(size_t size)
+{
+  return _pvalloc_r(NULL, size);
+}
+
+size_t malloc_usable_size(void *ptr)
+{
+  return _malloc_usable_size_r(NULL, ptr);
+}
+
+struct mallinfo mallinfo(void)
+{
+  return _mallinfo_r(NULL);
+}
+
+void malloc_stats(void)
+{
+  _malloc_stats_r(NULL);
+}
+
+int malloc_trim(size_t pad)
+{
+  return _malloc_trim_r(NULL, pad);
+}
+
+int mallopt(int param, int value)
+{
+  return _mallopt_r(NULL, param, value);
 }
@@ -0,0 +1,309 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : String_Library                                    	 */
+/* File          : OmarOS_ATBench.c 			                         */
+/* Date          : Jun 22, 2023                                          */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+/*
+ * =============================================
+ * AT command parsing benchmark (host tool)
+ * =============================================
+ *
+ * Times the case-insensitive string functions on an AT command workload, against what a caller had
+ * to do with the V1 functions. Build and run on the host:
+ *
+ * 		gcc -O2 -fno-tree-loop-distribute-patterns -IOmarOS/Inc -o omaros_atbench Tools/OmarOS_ATBench.c OmarOS/string_lib.c
+ * 		./omaros_atbench [-n Iterations]
+ *
+ * The V1 STRING_compare_caseInsensitive didn't move past letters that only differ in case (it
+ * looped forever on them), so V1 callers copied the line, converted the copy with
+ * STRING_convert_upperCase and matched it case sensitively. The V1 functions are kept as they were
+ * apart from their names.
+ *
+ * Workloads, over 1024 lines written in random letter case:
+ * 		dispatch		commands like "at+CwJaP=\"ssid\",\"pass\"" looked up in a table of 16 ESP8266
+ * 						commands, the name must be followed by '=', '?' or the end of the line
+ * 						new: STRING_compare_caseInsensitive_length on the line as it is
+ * 						V1:  STRING_copy, STRING_convert_upperCase, STRING_compare_caseSensitive_length
+ * 		response		modem replies like "+CIFSR:STAIP,\"192.168.4.1\"\r\n\r\nok\r\n" searched for "OK"
+ * 						then "ERROR"
+ * 						new: STRING_word_firstOccurrence_caseInsensitive
+ * 						V1:  STRING_copy, STRING_convert_upperCase, STRING_word_firstOccurrence
+ *
+ * Both sides must find the same command and result for every line, this is checked. Results are
+ * in nanoseconds per line on the host, they are not target figures.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "string_lib.h"
+
+//----------------------------------------------
+// Section: Macros Configuration References
+//----------------------------------------------
+#define BENCH_LINES				1024
+#define BENCH_LINE_SIZE			96
+#define BENCH_ITERATIONS		2000UL
+
+static const char* const Bench_Commands[] = {
+	"AT", "AT+RST", "AT+GMR", "AT+CWMODE", "AT+CWJAP", "AT+CWLAP", "AT+CWQAP", "AT+CIPSTATUS",
+	"AT+CIPSTART", "AT+CIPSEND", "AT+CIPCLOSE", "AT+CIFSR", "AT+CIPMUX", "AT+CIPSERVER", "AT+CIPMODE", "AT+UART_DEF"
+};
+#define BENCH_COMMANDS			(sizeof(Bench_Commands) / sizeof(Bench_Commands[0]))
+
+static const char* const Bench_Parameters[] = {
+	"", "?", "=1", "=\"HomeNetwork\",\"secret-pass\"", "=\"TCP\",\"192.168.1.10\",8080", "=115200,8,1,0,0"
+};
+
+static const char* const Bench_Replies[] = {
+	"+CIFSR:STAIP,\"192.168.4.1\"\r\n+CIFSR:STAMAC,\"5c:cf:7f:a0:b1:c2\"\r\n\r\n",
+	"+CWJAP:\"HomeNetwork\",\"aa:bb:cc:dd:ee:ff\",6,-58\r\n\r\n",
+	"+CIPSTATUS:0,\"TCP\",\"192.168.1.10\",8080,0\r\n\r\n",
+	"busy p...\r\n\r\n",
+	"\r\n"
+};
+
+//----------------------------------------------
+// Section: V1 functions
+//----------------------------------------------
+static void V1_convert_upperCase(unsigned char* str){
+	/* Validate that we are not accessing a null pointer */
+	if(NULL != str){
+		/* Loop on array characters until finding a terminating null */
+		while(*str){
+			/* If lower case character is found convert it to upper case */
+			if(('a' <= *str) && ('z' >= *str)){
+				*str -= 32;
+			}
+			else{ /* Do Nothing */ }
+			str++;
+		}
+	}
+	else{ /* Do Nothing */ }
+}
+
+static signed char V1_compare_caseSensitive_length(const unsigned char* str1, const unsigned char* str2, const unsigned short length){
+	signed char ret_val = 0;
+	/* Validate that we are not accessing a null pointer */
+	if( (NULL != str1) && (NULL != str2) ){
+		unsigned short index;
+		/* Navigate in the two strings */
+		for(index = 0; (index < length) && ('\0' != *str1) && ('\0' != *str2); index++){
+			/* Check if two characters are identicals */
+			if(str1[index] != str2[index]){
+				if(str1[index] < str2[index]){
+					ret_val = -1;
+				}
+				else{
+					ret_val = 1;
+				}
+				break;
+			}
+			else{ /* Do Nothing */ }
+		}
+	}
+	else{ /* Do Nothing */ }
+	return ret_val;
+}
+
+static unsigned short V1_copy(const unsigned char* src_str, unsigned char* des_str){
+	unsigned short index = 0;
+	/* Validate that we are not accessing a null pointer */
+	if( (NULL != src_str) && (NULL != des_str) ){
+		for(; '\0' != src_str[index]; index++){
+			des_str[index] = src_str[index];
+		}
+		des_str[index] = '\0';
+	}
+	else{ /* Do Nothing */ }
+	return index;
+}
+
+static unsigned char* V1_word_firstOccurrence(const unsigned char* str, const unsigned char* word){
+	unsigned char* ret_val = NULL;
+
+	/* Validate that we are not accessing a null pointer */
+	if( (NULL != str) && (NULL != word) ){
+		unsigned short str_index = 0;
+		unsigned short word_index;
+		while('\0' != str[str_index]){
+			/* Reset flag */
+			unsigned int found_flag = 0;
+			for(word_index = 0; ( ('\0' != word[word_index]) && ('\0' != str[str_index + word_index]) ) ; word_index++){
+				/* If characters are not equal, set a flag */
+				if(str[str_index + word_index] != word[word_index]){
+					found_flag |= 1;
+				}
+				else{ /* Do Nothing */ }
+			}
+			if(0 == found_flag){
+				/* If found, set return value and break while loop */
+				ret_val = (unsigned char*)&(str[str_index]);
+				break;
+			}
+			else{ /* Do Nothing */ }
+			str_index++;
+		}
+	}
+	else{ /* Do Nothing */ }
+	return ret_val;
+}
+
+//----------------------------------------------
+// Section: Workloads
+//----------------------------------------------
+static unsigned char Commands[BENCH_LINES][BENCH_LINE_SIZE];
+static unsigned char Replies[BENCH_LINES][BENCH_LINE_SIZE];
+static unsigned short Lengths[BENCH_COMMANDS];
+static unsigned long Checksum[2];
+
+static double Bench_Now(void){
+	struct timespec Now;
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+/* Copies "pText" to "pLine" with every letter in a random case */
+static unsigned char* Bench_Scramble(unsigned char* pLine, const char* pText, unsigned int* pSeed){
+	while('\0' != *pText){
+		*pSeed = (*pSeed * 1103515245U) + 12345U;
+		*pLine = (unsigned char)*pText++;
+		if((((*pLine | 0x20) >= 'a') && ((*pLine | 0x20) <= 'z')) && ((*pSeed >> 16) & 1)){
+			*pLine ^= 0x20;
+		}
+		pLine++;
+	}
+	*pLine = '\0';
+	return pLine;
+}
+
+static void Bench_MakeLines(void){
+	static const char* const Results[] = { "OK\r\n", "ERROR\r\n", "SEND OK\r\n", "FAIL\r\n" };
+	unsigned int Seed = 1, line;
+	unsigned char* pEnd;
+
+	for(line = 0; line < BENCH_COMMANDS; line++){
+		Lengths[line] = (unsigned short)strlen(Bench_Commands[line]);
+	}
+	for(line = 0; line < BENCH_LINES; line++){
+		Seed = (Seed * 1103515245U) + 12345U;
+		pEnd = Bench_Scramble(Commands[line], Bench_Commands[(Seed >> 16) % BENCH_COMMANDS], &Seed);
+		Seed = (Seed * 1103515245U) + 12345U;
+		Bench_Scramble(pEnd, Bench_Parameters[(Seed >> 16) % (sizeof(Bench_Parameters) / sizeof(Bench_Parameters[0]))], &Seed);
+
+		Seed = (Seed * 1103515245U) + 12345U;
+		pEnd = Bench_Scramble(Replies[line], Bench_Replies[(Seed >> 16) % (sizeof(Bench_Replies) / sizeof(Bench_Replies[0]))], &Seed);
+		Seed = (Seed * 1103515245U) + 12345U;
+		Bench_Scramble(pEnd, Results[(Seed >> 16) % (sizeof(Results) / sizeof(Results[0]))], &Seed);
+	}
+}
+
+/* The name is a match when the line goes on with a parameter, a query or nothing */
+static unsigned char Bench_Terminates(unsigned char c){
+	return ('\0' == c) || ('=' == c) || ('?' == c);
+}
+
+static unsigned long Bench_Dispatch(const unsigned char* pLine){
+	unsigned long command;
+	for(command = 0; command < BENCH_COMMANDS; command++){
+		if((0 == STRING_compare_caseInsensitive_length(pLine, (const unsigned char*)Bench_Commands[command], Lengths[command]))
+				&& Bench_Terminates(pLine[Lengths[command]])){
+			return command + 1;
+		}
+	}
+	return 0;
+}
+
+static unsigned long V1_Dispatch(const unsigned char* pLine){
+	unsigned char Upper[BENCH_LINE_SIZE];
+	unsigned long command;
+
+	V1_copy(pLine, Upper);
+	V1_convert_upperCase(Upper);
+	for(command = 0; command < BENCH_COMMANDS; command++){
+		if((0 == V1_compare_caseSensitive_length(Upper, (const unsigned char*)Bench_Commands[command], Lengths[command]))
+				&& Bench_Terminates(Upper[Lengths[command]])){
+			return command + 1;
+		}
+	}
+	return 0;
+}
+
+/* 1: OK, 2: ERROR, 0: neither */
+static unsigned long Bench_Response(const unsigned char* pReply){
+	if(NULL != STRING_word_firstOccurrence_caseInsensitive(pReply, (const unsigned char*)"OK")){
+		return 1;
+	}
+	return (NULL != STRING_word_firstOccurrence_caseInsensitive(pReply, (const unsigned char*)"ERROR")) ? 2 : 0;
+}
+
+static unsigned long V1_Response(const unsigned char* pReply){
+	unsigned char Upper[BENCH_LINE_SIZE];
+
+	V1_copy(pReply, Upper);
+	V1_convert_upperCase(Upper);
+	if(NULL != V1_word_firstOccurrence(Upper, (const unsigned char*)"OK")){
+		return 1;
+	}
+	return (NULL != V1_word_firstOccurrence(Upper, (const unsigned char*)"ERROR")) ? 2 : 0;
+}
+
+static double Bench_Run(unsigned long (*pfParse)(const unsigned char*), unsigned char (*pLines)[BENCH_LINE_SIZE], unsigned long* pChecksum, unsigned long Iterations){
+	unsigned long loop, Sum = 0;
+	unsigned int line;
+	double Start = Bench_Now();
+
+	for(loop = 0; loop < Iterations; loop++){
+		for(line = 0; line < BENCH_LINES; line++){
+			Sum += pfParse(pLines[line]) * (line + 1);
+		}
+	}
+	*pChecksum = Sum;
+	return (Bench_Now() - Start) / ((double)Iterations * BENCH_LINES);
+}
+
+//----------------------------------------------
+// Section: Main
+//----------------------------------------------
+int main(int argc, char* argv[]){
+	unsigned long Iterations = BENCH_ITERATIONS;
+	unsigned char Failed = 0;
+	unsigned int line;
+	double Old, New;
+
+	if((argc == 3) && (strcmp(argv[1], "-n") == 0) && (atol(argv[2]) > 0)){
+		Iterations = (unsigned long)atol(argv[2]);
+	}
+	else if(argc != 1){
+		fprintf(stderr, "usage: %s [-n Iterations]\n", argv[0]);
+		return 2;
+	}
+
+	Bench_MakeLines();
+
+	/* Every line holds a command of the table */
+	for(line = 0; line < BENCH_LINES; line++){
+		Failed |= (0 == Bench_Dispatch(Commands[line]));
+	}
+
+	printf("%-10s %12s %12s %8s\n", "Workload", "V1 ns/line", "New ns/line", "Speedup");
+	Old = Bench_Run(V1_Dispatch, Commands, &Checksum[0], Iterations);
+	New = Bench_Run(Bench_Dispatch, Commands, &Checksum[1], Iterations);
+	Failed |= (Checksum[0] != Checksum[1]);
+	printf("%-10s %12.1f %12.1f %7.2fx\n", "dispatch", Old, New, Old / New);
+	Old = Bench_Run(V1_Response, Replies, &Checksum[0], Iterations);
+	New = Bench_Run(Bench_Response, Replies, &Checksum[1], Iterations);
+	Failed |= (Checksum[0] != Checksum[1]);
+	printf("%-10s %12.1f %12.1f %7.2fx\n", "response", Old, New, Old / New);
+
+	if(Failed){
+		fprintf(stderr, "V1 and new parsing disagree\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,261 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_FIFOBench.c 			                         */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+/*
+ * =============================================
+ * OmarOS FIFO benchmark (host tool)
+ * =============================================
+ *
+ * Times the generated FIFO of OmarOS_FIFO.h against the V1 FIFO it replaced (head/tail pointers,
+ * a separate counter and a pointer compare against the end of the buffer on every wrap). Build
+ * and run on the host:
+ *
+ * 		gcc -O2 -IOmarOS/Inc -o omaros_fifobench Tools/OmarOS_FIFOBench.c
+ * 		./omaros_fifobench [-n Iterations]
+ *
+ * The V1 code is kept as it was apart from the element size: V1 stepped 4 bytes at the wrap
+ * compare, here it is sizeof(element) so it runs on a 64 bits host.
+ *
+ * Workloads, with a FIFO of 128 task pointers like the Ready Queue:
+ * 		fill/drain		enqueue 127 elements (V1 can't hold 128) then dequeue them (OmarOS_UpdateSchedulerTable)
+ * 		rotate			dequeue one then enqueue it back (round robin in OmarOS_DecideNextTask)
+ * 		batch			fill/drain with the batch calls, 16 elements per call (generated FIFO only)
+ *
+ * Results are in nanoseconds per element moved, they compare the two versions on the same host
+ * and are not target cycle counts.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "OmarOS_FIFO.h"
+
+//----------------------------------------------
+// Section: Macros Configuration References
+//----------------------------------------------
+#define BENCH_FIFO_LENGTH		128
+#define BENCH_BATCH				16
+#define BENCH_ITERATIONS		200000UL
+
+typedef void* Bench_element;
+
+/* The FIFO under test */
+FIFO_DECLARE(BENCH, Bench_element);
+FIFO_DEFINE(BENCH, Bench_element)
+
+//----------------------------------------------
+// Section: V1 FIFO
+//----------------------------------------------
+typedef struct{
+	unsigned int counter;
+	Bench_element* head;
+	Bench_element* tail;
+	Bench_element* base;
+	unsigned int  length;
+}V1_Buf_t;
+
+static Buffer_status V1_init(V1_Buf_t* fifo, Bench_element* buff, unsigned int length){
+	if(!buff)
+		return FIFO_NULL;
+	fifo->base = buff;
+	fifo->head = fifo->base;
+	fifo->tail = fifo->base;
+	fifo->length = length;
+	fifo->counter = 0;
+	return FIFO_NO_ERROR;
+}
+
+static Buffer_status V1_enqueue(V1_Buf_t* fifo, Bench_element item){
+	if(!fifo->base || !fifo->length)
+		return FIFO_NULL;
+	if((fifo->head == fifo->tail) && (fifo->counter == fifo->length))
+		return FIFO_FULL;
+	*(fifo->tail) = item;
+	fifo->counter++;
+	if((uintptr_t)fifo->tail == (((uintptr_t)fifo->base + (sizeof(Bench_element) * fifo->length)) - sizeof(Bench_element)))
+		fifo->tail = fifo->base;
+	else
+		fifo->tail++;
+	return FIFO_NO_ERROR;
+}
+
+static Buffer_status V1_dequeue(V1_Buf_t* fifo, Bench_element* item){
+	if(!fifo->base || !fifo->length)
+		return FIFO_NULL;
+	if(fifo->head == fifo->tail)
+		return FIFO_EMPTY;
+	*item = *(fifo->head);
+	fifo->counter--;
+	if((uintptr_t)fifo->head == (((uintptr_t)fifo->base + (sizeof(Bench_element) * fifo->length)) - sizeof(Bench_element)))
+		fifo->head = fifo->base;
+	else
+		fifo->head++;
+	return FIFO_NO_ERROR;
+}
+
+//----------------------------------------------
+// Section: Workloads
+//----------------------------------------------
+static Bench_element Storage[BENCH_FIFO_LENGTH];
+static Bench_element Items[BENCH_FIFO_LENGTH];
+static volatile uintptr_t Sink;
+
+static double Bench_Now(void){
+	struct timespec Now;
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+/* V1 reports a full FIFO as empty (head == tail), so it is filled to length - 1 */
+static double Bench_V1_FillDrain(unsigned long Iterations){
+	V1_Buf_t Fifo;
+	Bench_element Item = NULL;
+	unsigned long loop;
+	unsigned int index;
+	uintptr_t Sum = 0;
+	double Start;
+
+	V1_init(&Fifo, Storage, BENCH_FIFO_LENGTH);
+	Start = Bench_Now();
+	for(loop = 0; loop < Iterations; loop++){
+		for(index = 0; index < (BENCH_FIFO_LENGTH - 1); index++){
+			V1_enqueue(&Fifo, Items[index]);
+		}
+		while(V1_dequeue(&Fifo, &Item) == FIFO_NO_ERROR){
+			Sum += (uintptr_t)Item;
+		}
+	}
+	Sink = Sum;
+	return (Bench_Now() - Start) / ((double)Iterations * (BENCH_FIFO_LENGTH - 1));
+}
+
+static double Bench_FillDrain(unsigned long Iterations){
+	BENCH_Buf_t Fifo;
+	Bench_element Item = NULL;
+	unsigned long loop;
+	unsigned int index;
+	uintptr_t Sum = 0;
+	double Start;
+
+	BENCH_init(&Fifo, Storage, BENCH_FIFO_LENGTH);
+	Start = Bench_Now();
+	for(loop = 0; loop < Iterations; loop++){
+		for(index = 0; index < (BENCH_FIFO_LENGTH - 1); index++){
+			BENCH_enqueue(&Fifo, Items[index]);
+		}
+		while(BENCH_dequeue(&Fifo, &Item) == FIFO_NO_ERROR){
+			Sum += (uintptr_t)Item;
+		}
+	}
+	Sink = Sum;
+	return (Bench_Now() - Start) / ((double)Iterations * (BENCH_FIFO_LENGTH - 1));
+}
+
+static double Bench_V1_Rotate(unsigned long Iterations){
+	V1_Buf_t Fifo;
+	Bench_element Item = NULL;
+	unsigned long loop;
+	unsigned int index;
+	uintptr_t Sum = 0;
+	double Start;
+
+	V1_init(&Fifo, Storage, BENCH_FIFO_LENGTH);
+	for(index = 0; index < 8; index++){
+		V1_enqueue(&Fifo, Items[index]);
+	}
+	Start = Bench_Now();
+	for(loop = 0; loop < (Iterations * BENCH_FIFO_LENGTH); loop++){
+		V1_dequeue(&Fifo, &Item);
+		Sum += (uintptr_t)Item;
+		V1_enqueue(&Fifo, Item);
+	}
+	Sink = Sum;
+	return (Bench_Now() - Start) / ((double)Iterations * BENCH_FIFO_LENGTH);
+}
+
+static double Bench_Rotate(unsigned long Iterations){
+	BENCH_Buf_t Fifo;
+	Bench_element Item = NULL;
+	unsigned long loop;
+	unsigned int index;
+	uintptr_t Sum = 0;
+	double Start;
+
+	BENCH_init(&Fifo, Storage, BENCH_FIFO_LENGTH);
+	for(index = 0; index < 8; index++){
+		BENCH_enqueue(&Fifo, Items[index]);
+	}
+	Start = Bench_Now();
+	for(loop = 0; loop < (Iterations * BENCH_FIFO_LENGTH); loop++){
+		BENCH_dequeue(&Fifo, &Item);
+		Sum += (uintptr_t)Item;
+		BENCH_enqueue(&Fifo, Item);
+	}
+	Sink = Sum;
+	return (Bench_Now() - Start) / ((double)Iterations * BENCH_FIFO_LENGTH);
+}
+
+static double Bench_Batch(unsigned long Iterations){
+	BENCH_Buf_t Fifo;
+	Bench_element Out[BENCH_BATCH];
+	unsigned long loop;
+	unsigned int index, count;
+	uintptr_t Sum = 0;
+	double Start;
+
+	BENCH_init(&Fifo, Storage, BENCH_FIFO_LENGTH);
+	Start = Bench_Now();
+	for(loop = 0; loop < Iterations; loop++){
+		for(index = 0; index < BENCH_FIFO_LENGTH; index += BENCH_BATCH){
+			BENCH_enqueue_batch(&Fifo, &Items[index], BENCH_BATCH);
+		}
+		while((count = BENCH_dequeue_batch(&Fifo, Out, BENCH_BATCH)) != 0){
+			for(index = 0; index < count; index++){
+				Sum += (uintptr_t)Out[index];
+			}
+		}
+	}
+	Sink = Sum;
+	return (Bench_Now() - Start) / ((double)Iterations * BENCH_FIFO_LENGTH);
+}
+
+//----------------------------------------------
+// Section: Main
+//----------------------------------------------
+int main(int argc, char* argv[]){
+	unsigned long Iterations = BENCH_ITERATIONS;
+	unsigned int index;
+	double Old, New;
+
+	if((argc == 3) && (strcmp(argv[1], "-n") == 0) && (atol(argv[2]) > 0)){
+		Iterations = (unsigned long)atol(argv[2]);
+	}
+	else if(argc != 1){
+		fprintf(stderr, "usage: %s [-n Iterations]\n", argv[0]);
+		return 2;
+	}
+
+	for(index = 0; index < BENCH_FIFO_LENGTH; index++){
+		Items[index] = (Bench_element)(uintptr_t)(index + 1);
+	}
+
+	printf("%-12s %12s %12s %8s\n", "Workload", "V1 ns/elem", "New ns/elem", "Speedup");
+	Old = Bench_V1_FillDrain(Iterations);
+	New = Bench_FillDrain(Iterations);
+	printf("%-12s %12.2f %12.2f %7.2fx\n", "fill/drain", Old, New, Old / New);
+	Old = Bench_V1_Rotate(Iterations);
+	New = Bench_Rotate(Iterations);
+	printf("%-12s %12.2f %12.2f %7.2fx\n", "rotate", Old, New, Old / New);
+	New = Bench_Batch(Iterations);
+	printf("%-12s %12s %12.2f %8s\n", "batch", "-", New, "-");
+
+	return 0;
+}
@@ -0,0 +1,571 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_KernelTest.c 			                         */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+/*
+ * =============================================
+ * OmarOS scheduler host test
+ * =============================================
+ *
+ * Builds OmarOS/scheduler.c on the host and drives it through the same entry points the
+ * Cortex-M3 uses: SysTick_Handler, the SVC handler and PendSV_Handler. Build and run on the host,
+ * kernel switches can be passed with -D like for the target build:
+ *
+ * 		gcc -O0 -IOmarOS/Inc -o omaros_kerneltest Tools/OmarOS_KernelTest.c
+ * 		./omaros_kerneltest
+ *
+ * The Cortex-M3 port (CortexMX_OS_porting.h) is replaced by host stand-ins:
+ * 		- Inline assembly is not run. An "svc #N" calls OmarOS_SVC_services with a stacked frame
+ * 		  whose PC points after an SVC N instruction, like the SVC exception would
+ * 		- PendSV is only pended, Test_RunPendSV runs it once the handler that pended it returned
+ * 		- The PSP is a variable, R4 to R11 are not saved, the tasks never really run: a test plays
+ * 		  a task by calling the kernel APIs while that task is OS_Control.CurrentTask
+ * 		- Registers bound to variables don't exist: a value stored to "register ... __asm("r0")"
+ * 		  goes to Test_R0, the stacked r0 of the next SVC, and the SVC result is left in Test_R0.
+ * 		  The function's own r0 variable is not updated, so OMAROS_USE_ADMISSION_CONTROL (the
+ * 		  activation result comes back in r0) is not supported and tests read results in Test_R0
+ * 		- The logger is built without its task (OMAROS_LOG_TASK 0), the tests read the records
+ *
+ * Exit code: 0 all checks passed, 1 a check failed
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+//----------------------------------------------
+// Section: Cortex-M3 port stand-ins
+//----------------------------------------------
+#define INC_CORTEXMX_OS_PORTING_H_
+#ifndef OMAROS_USE_LOG
+#define OMAROS_USE_LOG				1
+#endif
+#ifndef OMAROS_LOG_TASK
+#define OMAROS_LOG_TASK				0
+#endif
+#include "Platform_Types.h"
+#include "OmarOSConfig.h"
+
+#if (OMAROS_USE_ADMISSION_CONTROL == 1)
+#error "OmarOS_ActivateTask returns through r0 with OMAROS_USE_ADMISSION_CONTROL, it can't be built on the host"
+#endif
+
+/* RAM for the main and task stacks, _eheap is the lowest address tasks may use */
+static uint32 Test_RAM[16384];
+#define _estack					Test_RAM[16384]
+#define _eheap					Test_RAM[0]
+#define MainStackSize			3072
+#define OS_CPU_CLOCK_HZ			8000000UL
+
+static uint8 Test_PendSVPending;
+static uint32* Test_PSP;
+static uint32 Test_IPSR;
+static uint32 Test_R0;			/* Stacked r0 of the next SVC, then its result */
+
+#define Trigger_OS_PendSV()			(Test_PendSVPending = 1)
+#define OS_SET_PSP(address)			(Test_PSP = (uint32*)(address))
+#define OS_GET_PSP(address)			((address) = Test_PSP)
+#define OS_SWITCH_SP_to_PSP()
+#define OS_SWITCH_SP_to_MSP()
+#define OS_SET_CPU_PRIVILEGED()
+#define OS_SET_CPU_UNPRIVILIGED()
+
+void HW_Init(void){}
+void Start_Ticker(void){}
+
+#define __disable_irq()
+#define __enable_irq()
+#define __LDREXW(address)			(*(address))
+#define __STREXW(value, address)	((*(address) = (value)), 0U)
+#define __CLREX()
+#define __DMB()
+#define __get_IPSR()				(Test_IPSR)
+#define __get_CONTROL()				(0UL)
+#define CONTROL_nPRIV_Msk			(1UL)
+#define SCB_ICSR_PENDSTSET_Msk		(1UL << 26)
+#define SCB_ICSR_PENDSVSET_Msk		(1UL << 28)
+
+static struct{ uint32 CTRL, LOAD, VAL; } Test_SysTick = { 0, 7999, 7999 };
+static struct{ uint32 ICSR; } Test_SCB;
+#define SysTick						(&Test_SysTick)
+#define SCB							(&Test_SCB)
+
+/* "__asm (...)", "__asm volatile (...)" and "register ... __asm("r0")" become calls to Test_Asm,
+ * "naked" is dropped so the compiler builds PendSV_Handler as a normal function */
+static uint32* Test_Asm(const char* pCode);
+#define __asm(...)					; *Test_Asm(#__VA_ARGS__)
+#define volatile(...)				("") ; *Test_Asm(#__VA_ARGS__)
+#define naked						noinline
+#pragma GCC diagnostic ignored "-Wunused-value"
+/* The tests play the SVCs through Test_R0, the register bound locals of the SVC wrappers are never read */
+#pragma GCC diagnostic ignored "-Wuninitialized"
+
+#include "../OmarOS/scheduler.c"
+#include "../OmarOS/string_lib.c"
+#include "../OmarOS/OmarOS_Log.c"
+
+#undef __asm
+#undef volatile
+
+//----------------------------------------------
+// Section: Test helpers
+//----------------------------------------------
+static int Test_Failures, Test_Checks;
+
+#define TEST_CHECK(condition)	Test_Check((condition), #condition, __LINE__)
+
+static void Test_Check(int Condition, const char* pText, int Line){
+	Test_Checks++;
+	if(!Condition){
+		Test_Failures++;
+		printf("    FAILED line %d: %s\n", Line, pText);
+	}
+}
+
+/* Runs the SVC handler for "svc #Number", entered from the current context */
+static void Test_SVC(uint8 Number){
+	uint8 Code[4] = { 0, 0xDF, 0, 0 };
+	uint32 Frame[8] = { 0 };
+	uint32 IPSR = Test_IPSR;
+
+	Code[0] = Number;
+	Frame[0] = Test_R0;
+	Frame[6] = (uint32)&Code[2];
+	Test_IPSR = 11;
+	OmarOS_SVC_services(Frame);
+	Test_IPSR = IPSR;
+	Test_R0 = Frame[0];
+}
+
+static uint32* Test_Asm(const char* pCode){
+	static uint32 Register;
+	const char* pSvc = strstr(pCode, "svc #0x");
+
+	if(pSvc != NULL){
+		Test_SVC((uint8)strtoul(pSvc + 7, NULL, 16));
+	}
+	else if(strcmp(pCode, "\"r0\"") == 0){
+		return &Test_R0;
+	}
+	return &Register;
+}
+
+/* PendSV has the lowest priority, it runs once the handler that pended it returned */
+static void Test_RunPendSV(void){
+	while(Test_PendSVPending){
+		Test_PendSVPending = 0;
+		Test_IPSR = 14;
+		PendSV_Handler();
+		Test_IPSR = 0;
+	}
+}
+
+static void Test_Tick(void){
+	Test_IPSR = 15;
+	SysTick_Handler();
+	Test_IPSR = 0;
+	Test_RunPendSV();
+}
+
+/* Each test starts from a cleared kernel, OmarOS_Init expects the zeroed OS_Control of a reset */
+static void Test_Reset(void){
+	memset(&OS_Control, 0, sizeof(OS_Control));
+	Test_PendSVPending = 0;
+	Test_IPSR = 0;
+}
+
+/* OmarOS_StartOS without jumping into the idle task */
+static void Test_StartOS(void){
+	OS_Control.OS_ModeID = OS_Running;
+	OS_Control.CurrentTask = &IDLE_TASK;
+	OmarOS_ActivateTask(&IDLE_TASK);
+	OS_SET_PSP(OS_Control.CurrentTask->Current_PSP);
+	Test_RunPendSV();
+}
+
+static void Test_Entry(void){
+}
+
+//----------------------------------------------
+// Section: Tests
+//----------------------------------------------
+static Task_ref TaskA, TaskC;
+
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_FIXED_PRIORITY)
+/* A higher priority task woken by SysTick must preempt the running task also when that task's
+ * quantum ends on the same tick (TimeSlice 1): the tick's own round robin decision must not
+ * replace the switch the wake up already pended */
+static void Test_WakeUpAtSliceEnd(void){
+	static const Task_Config A_CONFIG = {
+		OMAROS_TASK_NAME("A"),
+		.pf_TaskEntry = Test_Entry,
+		.Stack_Size = 256,
+		.Priority = 1,
+		.AutoStart = Autostart_Enabled
+	};
+	static const Task_Config C_CONFIG = {
+		OMAROS_TASK_NAME("C"),
+		.pf_TaskEntry = Test_Entry,
+		.Stack_Size = 256,
+		.Priority = 2,
+		.TimeSlice = 1,
+		.AutoStart = Autostart_Enabled
+	};
+
+	printf("wake up at the end of a quantum\n");
+	TaskA.pConfig = &A_CONFIG;
+	TaskC.pConfig = &C_CONFIG;
+	Test_Reset();
+	TEST_CHECK(OmarOS_Init() == noError);
+	TEST_CHECK(OmarOS_CreateTask(&TaskA) == noError);
+	TEST_CHECK(OmarOS_CreateTask(&TaskC) == noError);
+	Test_StartOS();
+
+	/* Idle hands over to A on the first tick */
+	Test_Tick();
+	TEST_CHECK(OS_Control.CurrentTask == &TaskA);
+
+	/* A sleeps one tick, C runs */
+	OmarOS_TaskWait(1, &TaskA);
+	Test_RunPendSV();
+	TEST_CHECK(OS_Control.CurrentTask == &TaskC);
+	TEST_CHECK(TaskC.SliceRemaining == 1);
+
+	/* A wakes on the tick that also ends C's quantum */
+	Test_Tick();
+	TEST_CHECK(OS_Control.CurrentTask == &TaskA);
+	TEST_CHECK(TaskA.TaskState == Running);
+	TEST_CHECK(TaskC.TaskState != Suspended);
+
+	/* A sleeps again, C is still schedulable */
+	OmarOS_TaskWait(5, &TaskA);
+	Test_RunPendSV();
+	TEST_CHECK(OS_Control.CurrentTask == &TaskC);
+}
+#else
+/* Tasks started by OmarOS_StartOS get their first deadline from the start tick like activated
+ * ones, a first job that ends in time is not counted as a miss */
+static void Test_AutoStartDeadline(void){
+	static const Task_Config A_CONFIG = {
+		OMAROS_TASK_NAME("A"),
+		.pf_TaskEntry = Test_Entry,
+		.Stack_Size = 256,
+		.Priority = 1,
+		.RelativeDeadline = 10,
+		.AutoStart = Autostart_Enabled
+	};
+	static const Task_Config C_CONFIG = {
+		OMAROS_TASK_NAME("C"),
+		.pf_TaskEntry = Test_Entry,
+		.Stack_Size = 256,
+		.Priority = 1,
+		.RelativeDeadline = 20,
+		.AutoStart = Autostart_Enabled
+	};
+
+	printf("deadline of auto started tasks\n");
+	TaskA.pConfig = &A_CONFIG;
+	TaskC.pConfig = &C_CONFIG;
+	Test_Reset();
+	TEST_CHECK(OmarOS_Init() == noError);
+	TEST_CHECK(OmarOS_CreateTask(&TaskC) == noError);
+	TEST_CHECK(OmarOS_CreateTask(&TaskA) == noError);
+	Test_StartOS();
+	TEST_CHECK(TaskA.AbsDeadline == 10);
+	TEST_CHECK(TaskC.AbsDeadline == 20);
+
+	/* The earliest deadline runs first, whatever the creation order */
+	Test_Tick();
+	TEST_CHECK(OS_Control.CurrentTask == &TaskA);
+
+	/* Both first jobs end before their deadline */
+	OmarOS_TaskWait(5, &TaskA);
+	Test_RunPendSV();
+	TEST_CHECK(OS_Control.CurrentTask == &TaskC);
+	Test_Tick();
+	OmarOS_TaskWait(5, &TaskC);
+	Test_RunPendSV();
+	TEST_CHECK(TaskA.DeadlineMisses == 0);
+	TEST_CHECK(TaskC.DeadlineMisses == 0);
+	TEST_CHECK(OS_Control.CurrentTask == &IDLE_TASK);
+
+	/* A is released again at tick 6 with the deadline 16 */
+	while(OS_Control.TickCount < 6){
+		Test_Tick();
+	}
+	TEST_CHECK(OS_Control.CurrentTask == &TaskA);
+	TEST_CHECK(TaskA.AbsDeadline == 16);
+}
+
+/* Tasks without a deadline run behind the others and take turns when their quantum ends, a
+ * service task without a deadline can't be starved by another one */
+static void Test_BackgroundRoundRobin(void){
+	static const Task_Config B_CONFIG = {
+		OMAROS_TASK_NAME("B"),
+		.pf_TaskEntry = Test_Entry,
+		.Stack_Size = 256,
+		.Priority = 1,
+		.TimeSlice = 1,
+		.AutoStart = Autostart_Enabled
+	};
+	static const Task_Config D_CONFIG = {
+		OMAROS_TASK_NAME("D"),
+		.pf_TaskEntry = Test_Entry,
+		.Stack_Size = 256,
+		.Priority = 1,
+		.RelativeDeadline = 3,
+		.AutoStart = Autostart_Disabled
+	};
+	static Task_ref TaskB, TaskD;
+	Task_ref* pFirst;
+
+	printf("background tasks in round robin\n");
+	TaskA.pConfig = &B_CONFIG;
+	TaskB.pConfig = &B_CONFIG;
+	TaskD.pConfig = &D_CONFIG;
+	Test_Reset();
+	TEST_CHECK(OmarOS_Init() == noError);
+	TEST_CHECK(OmarOS_CreateTask(&TaskA) == noError);
+	TEST_CHECK(OmarOS_CreateTask(&TaskB) == noError);
+	TEST_CHECK(OmarOS_CreateTask(&TaskD) == noError);
+	Test_StartOS();
+
+	Test_Tick();
+	pFirst = OS_Control.CurrentTask;
+	TEST_CHECK((pFirst == &TaskA) || (pFirst == &TaskB));
+	Test_Tick();
+	TEST_CHECK((OS_Control.CurrentTask != pFirst) && (OS_Control.CurrentTask != &IDLE_TASK));
+	Test_Tick();
+	TEST_CHECK(OS_Control.CurrentTask == pFirst);
+
+	/* A task with a deadline goes first, then the turns go on */
+	OmarOS_ActivateTask(&TaskD);
+	Test_RunPendSV();
+	TEST_CHECK(OS_Control.CurrentTask == &TaskD);
+	OmarOS_TerminateTask(&TaskD);
+	Test_RunPendSV();
+	TEST_CHECK((OS_Control.CurrentTask == &TaskA) || (OS_Control.CurrentTask == &TaskB));
+	TEST_CHECK(TaskD.DeadlineMisses == 0);
+}
+
+/* Terminating another task abandons its job, only a task ending its own job late is a miss */
+static void Test_TerminateOtherNoMiss(void){
+	static const Task_Config A_CONFIG = {
+		OMAROS_TASK_NAME("A"),
+		.pf_TaskEntry = Test_Entry,
+		.Stack_Size = 256,
+		.Priority = 1,
+		.RelativeDeadline = 2,
+		.AutoStart = Autostart_Enabled
+	};
+	static const Task_Config C_CONFIG = {
+		OMAROS_TASK_NAME("C"),
+		.pf_TaskEntry = Test_Entry,
+		.Stack_Size = 256,
+		.Priority = 1,
+		.RelativeDeadline = 3,
+		.AutoStart = Autostart_Enabled
+	};
+
+	printf("deadline miss of a terminated task\n");
+	TaskA.pConfig = &A_CONFIG;
+	TaskC.pConfig = &C_CONFIG;
+	Test_Reset();
+	TEST_CHECK(OmarOS_Init() == noError);
+	TEST_CHECK(OmarOS_CreateTask(&TaskA) == noError);
+	TEST_CHECK(OmarOS_CreateTask(&TaskC) == noError);
+	Test_StartOS();
+
+	/* Both deadlines pass while A runs */
+	while(OS_Control.TickCount < 5){
+		Test_Tick();
+	}
+	TEST_CHECK(OS_Control.CurrentTask == &TaskA);
+	OmarOS_TerminateTask(&TaskC);
+	Test_RunPendSV();
+	TEST_CHECK(TaskC.DeadlineMisses == 0);
+	TEST_CHECK(OS_Control.CurrentTask == &TaskA);
+
+	OmarOS_TerminateTask(&TaskA);
+	Test_RunPendSV();
+	TEST_CHECK(TaskA.DeadlineMisses == 1);
+	TEST_CHECK(OmarOS_GetDeadlineMisses() == 1);
+	TEST_CHECK(OS_Control.CurrentTask == &IDLE_TASK);
+}
+#endif
+
+/* Tasks that delete themselves wait in the Deleted Queue until the idle task releases their stacks.
+ * Once it is full a self delete is refused and the task keeps running, nothing is leaked */
+static void Test_DeleteQueueFull(void){
+	static const Task_Config T_CONFIG = {
+		OMAROS_TASK_NAME("T"),
+		.pf_TaskEntry = Test_Entry,
+		.Stack_Size = 256,
+		.Priority = 1,
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+		.RelativeDeadline = 100,
+#endif
+		.AutoStart = Autostart_Enabled
+	};
+	static Task_ref Tasks[DELETED_QUEUE_SIZE + 1];
+	Task_ref* pTask;
+	uint32 index, PSP_Task_Locator;
+
+	printf("self delete with a full Deleted Queue\n");
+	Test_Reset();
+	TEST_CHECK(OmarOS_Init() == noError);
+	PSP_Task_Locator = OS_Control.PSP_Task_Locator;
+	for(index = 0; index <= DELETED_QUEUE_SIZE; index++){
+		Tasks[index].pConfig = &T_CONFIG;
+		TEST_CHECK(OmarOS_CreateTask(&Tasks[index]) == noError);
+	}
+	Test_StartOS();
+	Test_Tick();
+
+	/* OmarOS_DeleteTask never returns to a task that deleted itself, only its SVC is played */
+	for(index = 0; index < DELETED_QUEUE_SIZE; index++){
+		pTask = OS_Control.CurrentTask;
+		TEST_CHECK(pTask != &IDLE_TASK);
+		Test_R0 = (uint32)pTask;
+		Test_SVC(SVC_DeleteTask);
+		TEST_CHECK(Test_R0 == noError);
+		Test_RunPendSV();
+		TEST_CHECK(OS_Control.CurrentTask != pTask);
+	}
+	TEST_CHECK(FIFO_count(&Deleted_QUEUE) == DELETED_QUEUE_SIZE);
+
+	/* The last one is refused and stays scheduled */
+	pTask = OS_Control.CurrentTask;
+	TEST_CHECK(pTask != &IDLE_TASK);
+	Test_R0 = (uint32)pTask;
+	Test_SVC(SVC_DeleteTask);
+	Test_RunPendSV();
+	TEST_CHECK(Test_R0 == TaskDeleteQueueFull);
+	TEST_CHECK(OS_Control.CurrentTask == pTask);
+	TEST_CHECK(OS_Control.NoOfActiveTasks == 2);
+
+	/* The idle task releases the queued stacks, then the delete goes through */
+	OmarOS_ReclaimDeletedStacks();
+	TEST_CHECK(FIFO_count(&Deleted_QUEUE) == 0);
+	Test_R0 = (uint32)pTask;
+	Test_SVC(SVC_DeleteTask);
+	Test_RunPendSV();
+	TEST_CHECK(Test_R0 == noError);
+	TEST_CHECK(OS_Control.CurrentTask == &IDLE_TASK);
+	OmarOS_ReclaimDeletedStacks();
+
+	/* Every stack came back to the PSP Stack */
+	TEST_CHECK(OS_Control.PSP_Task_Locator == PSP_Task_Locator);
+	TEST_CHECK(OS_Control.FreeStacks == NULL);
+}
+
+/* A task may terminate itself under one level of OmarOS_SuspendScheduler (the console task does):
+ * it keeps running until OmarOS_ResumeScheduler, which does the pended switch */
+static void Test_TerminateSelfSuspended(void){
+	static const Task_Config A_CONFIG = {
+		OMAROS_TASK_NAME("A"),
+		.pf_TaskEntry = Test_Entry,
+		.Stack_Size = 256,
+		.Priority = 1,
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+		.RelativeDeadline = 10,
+#endif
+		.AutoStart = Autostart_Enabled
+	};
+	static const Task_Config C_CONFIG = {
+		OMAROS_TASK_NAME("C"),
+		.pf_TaskEntry = Test_Entry,
+		.Stack_Size = 256,
+		.Priority = 2,
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_EDF)
+		.RelativeDeadline = 20,
+#endif
+		.AutoStart = Autostart_Enabled
+	};
+
+	printf("self terminate with the scheduler suspended\n");
+	TaskA.pConfig = &A_CONFIG;
+	TaskC.pConfig = &C_CONFIG;
+	Test_Reset();
+	TEST_CHECK(OmarOS_Init() == noError);
+	TEST_CHECK(OmarOS_CreateTask(&TaskA) == noError);
+	TEST_CHECK(OmarOS_CreateTask(&TaskC) == noError);
+	Test_StartOS();
+	Test_Tick();
+	TEST_CHECK(OS_Control.CurrentTask == &TaskA);
+
+	/* Nothing switches before the resume */
+	OmarOS_SuspendScheduler();
+	OmarOS_TerminateTask(&TaskA);
+	Test_RunPendSV();
+	TEST_CHECK(OS_Control.CurrentTask == &TaskA);
+	TEST_CHECK(TaskA.TaskState == Suspended);
+	OmarOS_ResumeScheduler();
+	Test_RunPendSV();
+	TEST_CHECK(OS_Control.CurrentTask == &TaskC);
+	TEST_CHECK(OS_Control.SchedulerLockCount == 0);
+
+	/* Activated again, it goes on after its resume */
+	OmarOS_ActivateTask(&TaskA);
+	Test_RunPendSV();
+	TEST_CHECK(OS_Control.CurrentTask == &TaskA);
+}
+
+#if (OMAROS_USE_LOG == 1)
+/* Pointers go through OMAROS_LOG like integers, and OmarOS_LogPrint passes each argument to printf
+ * with the type of its conversion: a %s record prints the string */
+static void Test_LogString(void){
+	static const char Name[] = "sensor";
+	Log_record Record;
+	char Line[64] = { 0 };
+	FILE* pFile;
+	int Stdout;
+
+	printf("log record with a string\n");
+	Test_Reset();
+	TEST_CHECK(OmarOS_Init() == noError);
+	OMAROS_LOG("%s ready, %u tasks, %-4d|%5s| 100%%", Name, 3, -2, "ok");
+	TEST_CHECK(OmarOS_LogRead(&Record) == 1);
+	TEST_CHECK(Record.NoOfArgs == 4);
+	TEST_CHECK(Record.Args[0] == (uintptr_t)Name);
+
+	/* Print it to a file in place of stdout */
+	pFile = tmpfile();
+	fflush(stdout);
+	Stdout = dup(STDOUT_FILENO);
+	dup2(fileno(pFile), STDOUT_FILENO);
+	OmarOS_LogPrint(&Record);
+	fflush(stdout);
+	dup2(Stdout, STDOUT_FILENO);
+	close(Stdout);
+	rewind(pFile);
+	TEST_CHECK(fgets(Line, sizeof(Line), pFile) != NULL);
+	fclose(pFile);
+	TEST_CHECK(strcmp(Line, "       0: sensor ready, 3 tasks, -2  |   ok| 100%\n") == 0);
+	TEST_CHECK(OmarOS_LogRead(&Record) == 0);
+}
+#endif
+
+int main(void){
+#if (OMAROS_SCHEDULER_POLICY == OMAROS_POLICY_FIXED_PRIORITY)
+	Test_WakeUpAtSliceEnd();
+#else
+	Test_AutoStartDeadline();
+	Test_BackgroundRoundRobin();
+	Test_TerminateOtherNoMiss();
+#endif
+	Test_DeleteQueueFull();
+	Test_TerminateSelfSuspended();
+#if (OMAROS_USE_LOG == 1)
+	Test_LogString();
+#endif
+
+	printf("%d checks, %d failed\n", Test_Checks, Test_Failures);
+	return (Test_Failures == 0) ? 0 : 1;
+}
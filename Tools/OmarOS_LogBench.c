@@ -0,0 +1,215 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_LogBench.c 			                         */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+/*
+ * =============================================
+ * OmarOS deferred logger benchmark (host tool)
+ * =============================================
+ *
+ * Times the caller's side of OMAROS_LOG against formatting the same message with the C library.
+ * Build and run on the host:
+ *
+ * 		gcc -O2 -IOmarOS/Inc -o omaros_logbench Tools/OmarOS_LogBench.c
+ * 		./omaros_logbench [-n Iterations]
+ *
+ * The LDREX/STREX and DMB stand-ins are plain loads and stores, the host runs the same record
+ * reservation without the exclusive monitor (a single thread never fails the store). The buffer
+ * is drained between batches, outside of the timing, so no record is dropped.
+ *
+ * Workloads, all with the message "adc %s channel %u = %d" (a string, an unsigned and an int):
+ * 		OMAROS_LOG		store the record, what a task or an ISR pays
+ * 		snprintf		format the message into a buffer
+ * 		fprintf			format and write it to /dev/null through stdio
+ * 		LogPrint		OmarOS_LogRead then OmarOS_LogPrint to /dev/null, what the log task pays later
+ *
+ * Results are in nanoseconds per message on the host. On the target printf also waits for _write
+ * to send every character, so only the OMAROS_LOG figure is spent by the caller there.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+//----------------------------------------------
+// Section: Cortex-M3 port stand-ins
+//----------------------------------------------
+#define INC_CORTEXMX_OS_PORTING_H_
+#define OMAROS_USE_LOG				1
+#define OMAROS_LOG_TASK				0
+#define OMAROS_LOG_BUFFER_SIZE		65536
+#include "Platform_Types.h"
+#include "OmarOSConfig.h"
+
+extern uint32 _estack, _eheap;
+#define MainStackSize				3072
+#define OS_CPU_CLOCK_HZ				8000000UL
+
+/* The indexes are uint32 (unsigned long, 64 bits on the host) read through uint32_t pointers like
+ * on the target, memcpy keeps the optimizer from assuming they don't alias */
+static inline uint32_t Bench_LDREXW(volatile uint32_t* pAddress){
+	uint32_t Value;
+	memcpy(&Value, (const void*)pAddress, sizeof(Value));
+	return Value;
+}
+
+static inline uint32_t Bench_STREXW(uint32_t Value, volatile uint32_t* pAddress){
+	memcpy((void*)pAddress, &Value, sizeof(Value));
+	return 0;
+}
+
+#define __LDREXW(address)			Bench_LDREXW(address)
+#define __STREXW(value, address)	Bench_STREXW((value), (address))
+#define __CLREX()
+#define __DMB()
+
+#include "../OmarOS/OmarOS_Log.c"
+
+uint32 OmarOS_GetTickCount(void){
+	return 0;
+}
+
+//----------------------------------------------
+// Section: Macros Configuration References
+//----------------------------------------------
+#define BENCH_FORMAT				"adc %s channel %u = %d"
+#define BENCH_ITERATIONS			20000UL
+
+/* Records of 3 arguments that fit in the buffer */
+#define BENCH_BATCH					(OMAROS_LOG_BUFFER_WORDS / OMAROS_LOG_RECORD_WORDS(3))
+
+//----------------------------------------------
+// Section: Workloads
+//----------------------------------------------
+static const char Bench_Name[] = "PA0";
+static volatile unsigned long Sink;
+
+static double Bench_Now(void){
+	struct timespec Now;
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+static void Bench_Drain(void){
+	Log_record Record;
+	while(OmarOS_LogRead(&Record));
+}
+
+static double Bench_Log(unsigned long Iterations){
+	unsigned long loop;
+	unsigned int index;
+	double Start, Time = 0;
+
+	for(loop = 0; loop < Iterations; loop++){
+		Start = Bench_Now();
+		for(index = 0; index < BENCH_BATCH; index++){
+			OMAROS_LOG(BENCH_FORMAT, Bench_Name, index, -(int)index);
+		}
+		Time += Bench_Now() - Start;
+		Bench_Drain();
+	}
+	return Time / ((double)Iterations * BENCH_BATCH);
+}
+
+static double Bench_Snprintf(unsigned long Iterations){
+	char Line[64];
+	unsigned long loop, Sum = 0;
+	unsigned int index;
+	double Start = Bench_Now();
+
+	for(loop = 0; loop < Iterations; loop++){
+		for(index = 0; index < BENCH_BATCH; index++){
+			Sum += (unsigned long)snprintf(Line, sizeof(Line), BENCH_FORMAT, Bench_Name, index, -(int)index);
+		}
+	}
+	Sink = Sum;
+	return (Bench_Now() - Start) / ((double)Iterations * BENCH_BATCH);
+}
+
+static double Bench_Fprintf(FILE* pNull, unsigned long Iterations){
+	unsigned long loop;
+	unsigned int index;
+	double Start = Bench_Now();
+
+	for(loop = 0; loop < Iterations; loop++){
+		for(index = 0; index < BENCH_BATCH; index++){
+			fprintf(pNull, BENCH_FORMAT "\n", Bench_Name, index, -(int)index);
+		}
+	}
+	fflush(pNull);
+	return (Bench_Now() - Start) / ((double)Iterations * BENCH_BATCH);
+}
+
+/* OmarOS_LogPrint writes to stdout, it is pointed at /dev/null while this runs */
+static double Bench_LogPrint(FILE* pNull, unsigned long Iterations){
+	Log_record Record;
+	unsigned long loop;
+	unsigned int index;
+	double Start, Time = 0;
+	int Stdout;
+
+	fflush(stdout);
+	Stdout = dup(STDOUT_FILENO);
+	dup2(fileno(pNull), STDOUT_FILENO);
+	for(loop = 0; loop < Iterations; loop++){
+		for(index = 0; index < BENCH_BATCH; index++){
+			OMAROS_LOG(BENCH_FORMAT, Bench_Name, index, -(int)index);
+		}
+		Start = Bench_Now();
+		while(OmarOS_LogRead(&Record)){
+			OmarOS_LogPrint(&Record);
+		}
+		Time += Bench_Now() - Start;
+	}
+	fflush(stdout);
+	dup2(Stdout, STDOUT_FILENO);
+	close(Stdout);
+	return Time / ((double)Iterations * BENCH_BATCH);
+}
+
+//----------------------------------------------
+// Section: Main
+//----------------------------------------------
+int main(int argc, char* argv[]){
+	unsigned long Iterations = BENCH_ITERATIONS;
+	Log_stats Stats;
+	FILE* pNull;
+
+	if((argc == 3) && (strcmp(argv[1], "-n") == 0) && (atol(argv[2]) > 0)){
+		Iterations = (unsigned long)atol(argv[2]);
+	}
+	else if(argc != 1){
+		fprintf(stderr, "usage: %s [-n Iterations]\n", argv[0]);
+		return 2;
+	}
+
+	pNull = fopen("/dev/null", "w");
+	if(NULL == pNull){
+		fprintf(stderr, "can't open /dev/null\n");
+		return 1;
+	}
+	OmarOS_LogInit();
+
+	printf("\"%s\", %lu messages per batch\n", BENCH_FORMAT, (unsigned long)BENCH_BATCH);
+	printf("%-12s %10s\n", "Workload", "ns/msg");
+	printf("%-12s %10.2f\n", "OMAROS_LOG", Bench_Log(Iterations));
+	printf("%-12s %10.2f\n", "snprintf", Bench_Snprintf(Iterations));
+	printf("%-12s %10.2f\n", "fprintf", Bench_Fprintf(pNull, Iterations));
+	printf("%-12s %10.2f\n", "LogPrint", Bench_LogPrint(pNull, Iterations));
+	fclose(pNull);
+
+	OmarOS_LogGetStats(&Stats);
+	if(Stats.Dropped != 0){
+		fprintf(stderr, "%lu records dropped\n", (unsigned long)Stats.Dropped);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,181 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_MemPoolBench.c 		                         */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+/*
+ * =============================================
+ * OmarOS memory pool benchmark (host tool)
+ * =============================================
+ *
+ * Times OmarOS_MemPoolAlloc/OmarOS_MemPoolFree against the C library malloc/free for blocks of
+ * one size. Build and run on the host:
+ *
+ * 		gcc -O2 -IOmarOS/Inc -o omaros_mempoolbench Tools/OmarOS_MemPoolBench.c
+ * 		./omaros_mempoolbench [-n Iterations]
+ *
+ * The pool is built with MEMPOOL_LOCK_FREE 0: the host has no LDREX/STREX and the lock free build
+ * stores the free list links in 32 bits words. The critical section stand-ins are empty, so both
+ * builds do the same free list pop and push. The host C library is glibc, not the newlib of the
+ * target: its malloc keeps per size caches that newlib's doesn't have, the numbers compare the two
+ * on the host and don't carry over to the target (measure there with the DWT cycle counter).
+ *
+ * Workloads, with BENCH_BLOCKS blocks of BENCH_BLOCK_SIZE bytes:
+ * 		pair		allocate one block and free it right away
+ * 		burst		allocate every block then free them in the reverse order
+ * 		random		keep every block allocated, free one picked at random and allocate again
+ *
+ * Results are in nanoseconds per allocation plus its free, averaged over the whole run. Single
+ * allocations are not timed, on the host reading the clock and the host scheduler cost more than
+ * the allocation itself.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//----------------------------------------------
+// Section: Cortex-M3 port stand-ins
+//----------------------------------------------
+#define INC_CORTEXMX_OS_PORTING_H_
+#define MEMPOOL_LOCK_FREE			0
+#include "Platform_Types.h"
+#include "OmarOSConfig.h"
+
+extern uint32 _estack, _eheap;
+#define MainStackSize				3072
+#define OS_CPU_CLOCK_HZ				8000000UL
+
+#define __get_PRIMASK()				(0UL)
+#define __set_PRIMASK(primask)		((void)(primask))
+#define __disable_irq()
+
+#include "../OmarOS/OmarOS_MemPool.c"
+
+//----------------------------------------------
+// Section: Macros Configuration References
+//----------------------------------------------
+#define BENCH_BLOCK_SIZE			32
+#define BENCH_BLOCKS				64
+#define BENCH_ITERATIONS			200000UL
+
+//----------------------------------------------
+// Section: Workloads
+//----------------------------------------------
+static MEMPOOL_BUFFER(Bench_Buffer, BENCH_BLOCK_SIZE, BENCH_BLOCKS);
+static MemPool_ref Bench_Pool;
+static void* Bench_Blocks[BENCH_BLOCKS];
+static volatile unsigned long Sink;
+
+static double Bench_Now(void){
+	struct timespec Now;
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+static void* Bench_PoolAlloc(void){
+	return OmarOS_MemPoolAlloc(&Bench_Pool);
+}
+
+static void Bench_PoolFree(void* pBlock){
+	OmarOS_MemPoolFree(&Bench_Pool, pBlock);
+}
+
+static void* Bench_Malloc(void){
+	return malloc(BENCH_BLOCK_SIZE);
+}
+
+static double Bench_Pair(void* (*pfAlloc)(void), void (*pfFree)(void*), unsigned long Iterations){
+	unsigned long loop, Sum = 0;
+	void* pBlock;
+	double Start = Bench_Now();
+
+	for(loop = 0; loop < (Iterations * BENCH_BLOCKS); loop++){
+		pBlock = pfAlloc();
+		Sum += (unsigned long)pBlock;
+		pfFree(pBlock);
+	}
+	Sink = Sum;
+	return (Bench_Now() - Start) / ((double)Iterations * BENCH_BLOCKS);
+}
+
+static double Bench_Burst(void* (*pfAlloc)(void), void (*pfFree)(void*), unsigned long Iterations){
+	unsigned long loop;
+	unsigned int index;
+	double Start = Bench_Now();
+
+	for(loop = 0; loop < Iterations; loop++){
+		for(index = 0; index < BENCH_BLOCKS; index++){
+			Bench_Blocks[index] = pfAlloc();
+		}
+		for(index = BENCH_BLOCKS; index > 0; index--){
+			pfFree(Bench_Blocks[index - 1]);
+		}
+	}
+	return (Bench_Now() - Start) / ((double)Iterations * BENCH_BLOCKS);
+}
+
+static double Bench_Random(void* (*pfAlloc)(void), void (*pfFree)(void*), unsigned long Iterations){
+	unsigned long loop;
+	unsigned int index, Seed = 1;
+	double Start, Mean;
+
+	for(index = 0; index < BENCH_BLOCKS; index++){
+		Bench_Blocks[index] = pfAlloc();
+	}
+
+	Start = Bench_Now();
+	for(loop = 0; loop < (Iterations * BENCH_BLOCKS); loop++){
+		Seed = (Seed * 1103515245U) + 12345U;
+		index = (Seed >> 16) % BENCH_BLOCKS;
+		pfFree(Bench_Blocks[index]);
+		Bench_Blocks[index] = pfAlloc();
+	}
+	Mean = (Bench_Now() - Start) / ((double)Iterations * BENCH_BLOCKS);
+
+	for(index = 0; index < BENCH_BLOCKS; index++){
+		pfFree(Bench_Blocks[index]);
+	}
+	return Mean;
+}
+
+//----------------------------------------------
+// Section: Main
+//----------------------------------------------
+int main(int argc, char* argv[]){
+	unsigned long Iterations = BENCH_ITERATIONS;
+	double Pool, Malloc;
+
+	if((argc == 3) && (strcmp(argv[1], "-n") == 0) && (atol(argv[2]) > 0)){
+		Iterations = (unsigned long)atol(argv[2]);
+	}
+	else if(argc != 1){
+		fprintf(stderr, "usage: %s [-n Iterations]\n", argv[0]);
+		return 2;
+	}
+
+	if(OmarOS_MemPoolInit(&Bench_Pool, Bench_Buffer, BENCH_BLOCK_SIZE, BENCH_BLOCKS) != noError){
+		fprintf(stderr, "pool init failed\n");
+		return 1;
+	}
+
+	printf("%d blocks of %d bytes\n", BENCH_BLOCKS, BENCH_BLOCK_SIZE);
+
+	printf("%-8s %12s %12s\n", "Workload", "Pool ns", "malloc ns");
+	Pool = Bench_Pair(Bench_PoolAlloc, Bench_PoolFree, Iterations);
+	Malloc = Bench_Pair(Bench_Malloc, free, Iterations);
+	printf("%-8s %12.2f %12.2f\n", "pair", Pool, Malloc);
+	Pool = Bench_Burst(Bench_PoolAlloc, Bench_PoolFree, Iterations);
+	Malloc = Bench_Burst(Bench_Malloc, free, Iterations);
+	printf("%-8s %12.2f %12.2f\n", "burst", Pool, Malloc);
+	Pool = Bench_Random(Bench_PoolAlloc, Bench_PoolFree, Iterations);
+	Malloc = Bench_Random(Bench_Malloc, free, Iterations);
+	printf("%-8s %12.2f %12.2f\n", "random", Pool, Malloc);
+
+	return 0;
+}
@@ -0,0 +1,212 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : String_Library                                    	 */
+/* File          : OmarOS_MemoryBench.c 		                         */
+/* Date          : Jun 22, 2023                                          */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+/*
+ * =============================================
+ * Memory copy benchmark (host tool)
+ * =============================================
+ *
+ * Times STRING_memory_copy and STRING_memory_move against the memcpy and memmove of newlib-nano.
+ * Build and run on the host:
+ *
+ * 		gcc -O2 -fno-tree-loop-distribute-patterns -IOmarOS/Inc -o omaros_memorybench Tools/OmarOS_MemoryBench.c
+ * 		./omaros_memorybench [-m Megabytes]
+ *
+ * newlib-nano is built with -Os, which defines __OPTIMIZE_SIZE__: its memcpy and memmove are then
+ * the byte loops of newlib/libc/string/memcpy.c and memmove.c (the PREFER_SIZE_OVER_SPEED path),
+ * copied below. -fno-tree-loop-distribute-patterns keeps GCC from replacing those loops, and the
+ * byte loops of string_lib, with calls to the host C library. The host memcpy and memmove are
+ * timed too, as the speed of an optimized library on this machine.
+ *
+ * The host builds the portable word loops of string_lib (8 bytes words), not the LDM/STM and
+ * unaligned LDR paths of the Cortex-M3. Cases:
+ * 		copy			copy between word aligned buffers
+ * 		copy+1			copy with the source one byte past a word boundary
+ * 		move			overlapping move with the destination 8 bytes after the source (backward copy)
+ * 		move+1			overlapping move with the destination 1 byte after the source
+ *
+ * Every copy is checked. Results are in bytes per nanosecond on the host, the best of 3 runs that
+ * each copy at least "Megabytes" (8 by default), they are not target figures. On the host both
+ * misaligned cases run byte loops in string_lib and in newlib-nano, they only differ by noise.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../OmarOS/string_lib.c"
+
+//----------------------------------------------
+// Section: Macros Configuration References
+//----------------------------------------------
+#define BENCH_MEGABYTES			8UL
+#define BENCH_MAX_SIZE			4096
+#define BENCH_MARGIN			16
+#define BENCH_REPEATS			3
+
+static const unsigned long Bench_Sizes[] = { 16, 64, 256, BENCH_MAX_SIZE };
+
+//----------------------------------------------
+// Section: newlib-nano memcpy and memmove
+//----------------------------------------------
+static void* Nano_memcpy(void* dst0, const void* src0, size_t len0){
+	char *dst = (char *) dst0;
+	char *src = (char *) src0;
+
+	void *save = dst0;
+
+	while (len0--)
+	{
+		*dst++ = *src++;
+	}
+
+	return save;
+}
+
+static void* Nano_memmove(void* dst_void, const void* src_void, size_t length){
+	char *dst = dst_void;
+	const char *src = src_void;
+
+	if (src < dst && dst < src + length)
+	{
+		/* Have to copy backwards */
+		src += length;
+		dst += length;
+		while (length--)
+		{
+			*--dst = *--src;
+		}
+	}
+	else
+	{
+		while (length--)
+		{
+			*dst++ = *src++;
+		}
+	}
+
+	return dst_void;
+}
+
+//----------------------------------------------
+// Section: Workloads
+//----------------------------------------------
+typedef void* (*Bench_copy)(void* des, const void* src, size_t size);
+
+static unsigned long __attribute__((aligned(8))) Src_Words[(BENCH_MAX_SIZE + BENCH_MARGIN) / sizeof(unsigned long)];
+static unsigned long __attribute__((aligned(8))) Des_Words[(BENCH_MAX_SIZE + BENCH_MARGIN) / sizeof(unsigned long)];
+static unsigned char* const Src = (unsigned char*)Src_Words;
+static unsigned char* const Des = (unsigned char*)Des_Words;
+static unsigned char Expected[BENCH_MAX_SIZE + BENCH_MARGIN];
+static unsigned long Errors;
+
+/* string_lib takes the source first */
+static void* Bench_StringCopy(void* des, const void* src, size_t size){
+	return STRING_memory_copy(src, des, size);
+}
+
+static void* Bench_StringMove(void* des, const void* src, size_t size){
+	return STRING_memory_move(src, des, size);
+}
+
+static double Bench_Now(void){
+	struct timespec Now;
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+static void Bench_Fill(unsigned char* pBuffer){
+	unsigned long index;
+	for(index = 0; index < (BENCH_MAX_SIZE + BENCH_MARGIN); index++){
+		pBuffer[index] = (unsigned char)((index * 7) + 1);
+	}
+}
+
+/* Copies "Size" bytes from Src + SrcOffset to Des + DesOffset, or moves them inside Src when
+ * "Overlap" is set. The fastest of BENCH_REPEATS runs is kept, then a copy is checked against memmove */
+static double Bench_Run(Bench_copy pfCopy, unsigned long Size, unsigned long SrcOffset, unsigned long DesOffset, unsigned char Overlap, unsigned long Megabytes){
+	unsigned long loop, Loops = ((Megabytes << 20) + Size - 1) / Size;
+	unsigned char* pDes = (Overlap) ? &Src[DesOffset] : &Des[DesOffset];
+	unsigned int repeat;
+	double Start, Best = 0;
+
+	Bench_Fill(Src);
+	Bench_Fill(Des);
+	for(repeat = 0; repeat < BENCH_REPEATS; repeat++){
+		Start = Bench_Now();
+		for(loop = 0; loop < Loops; loop++){
+			pfCopy(pDes, &Src[SrcOffset], Size);
+			__asm__ volatile ("" : : : "memory");
+		}
+		Start = Bench_Now() - Start;
+		if((0 == repeat) || (Start < Best)){
+			Best = Start;
+		}
+	}
+
+	/* A move repeated in place keeps shifting the data, only the last one is checked */
+	Bench_Fill(Src);
+	Bench_Fill(Des);
+	Bench_Fill(Expected);
+	memmove(&Expected[DesOffset], &Expected[SrcOffset], Size);
+	pfCopy(pDes, &Src[SrcOffset], Size);
+	if(Overlap){
+		Errors += (memcmp(Src, Expected, BENCH_MAX_SIZE + BENCH_MARGIN) != 0);
+	}
+	else{
+		Errors += (memcmp(&Des[DesOffset], &Expected[DesOffset], Size) != 0);
+	}
+
+	return ((double)Loops * Size) / Best;
+}
+
+//----------------------------------------------
+// Section: Main
+//----------------------------------------------
+int main(int argc, char* argv[]){
+	static const struct{
+		const char* Name;
+		Bench_copy pfNano, pfString, pfHost;
+		unsigned long SrcOffset, DesOffset;
+		unsigned char Overlap;
+	}Cases[] = {
+		{ "copy",	Nano_memcpy,	Bench_StringCopy,	memcpy,		0, 0, 0 },
+		{ "copy+1",	Nano_memcpy,	Bench_StringCopy,	memcpy,		1, 0, 0 },
+		{ "move",	Nano_memmove,	Bench_StringMove,	memmove,	0, 8, 1 },
+		{ "move+1",	Nano_memmove,	Bench_StringMove,	memmove,	0, 1, 1 },
+	};
+	unsigned long Megabytes = BENCH_MEGABYTES;
+	unsigned int Case, size;
+	double Nano, String, Host;
+
+	if((argc == 3) && (strcmp(argv[1], "-m") == 0) && (atol(argv[2]) > 0)){
+		Megabytes = (unsigned long)atol(argv[2]);
+	}
+	else if(argc != 1){
+		fprintf(stderr, "usage: %s [-m Megabytes]\n", argv[0]);
+		return 2;
+	}
+
+	printf("%-8s %6s %10s %10s %10s %8s\n", "Case", "Size", "nano B/ns", "STRING", "host libc", "vs nano");
+	for(Case = 0; Case < (sizeof(Cases) / sizeof(Cases[0])); Case++){
+		for(size = 0; size < (sizeof(Bench_Sizes) / sizeof(Bench_Sizes[0])); size++){
+			Nano = Bench_Run(Cases[Case].pfNano, Bench_Sizes[size], Cases[Case].SrcOffset, Cases[Case].DesOffset, Cases[Case].Overlap, Megabytes);
+			String = Bench_Run(Cases[Case].pfString, Bench_Sizes[size], Cases[Case].SrcOffset, Cases[Case].DesOffset, Cases[Case].Overlap, Megabytes);
+			Host = Bench_Run(Cases[Case].pfHost, Bench_Sizes[size], Cases[Case].SrcOffset, Cases[Case].DesOffset, Cases[Case].Overlap, Megabytes);
+			printf("%-8s %6lu %10.2f %10.2f %10.2f %7.2fx\n", Cases[Case].Name, Bench_Sizes[size], Nano, String, Host, String / Nano);
+		}
+	}
+
+	if(Errors != 0){
+		fprintf(stderr, "%lu wrong copies\n", Errors);
+		return 1;
+	}
+	return 0;
+}
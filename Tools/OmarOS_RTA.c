@@ -0,0 +1,547 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : OmarOS  	                                             */
+/* File          : OmarOS_RTA.c 			                             */
+/* Date          : Nov 7, 2023                                           */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+/*
+ * =============================================
+ * OmarOS schedulability analysis (host tool)
+ * =============================================
+ *
+ * Response time analysis of a fixed priority task set with priority ceiling blocking terms,
+ * plus the utilization bounds. Build and run on the host:
+ *
+ * 		gcc -O2 -o omaros_rta Tools/OmarOS_RTA.c -lm
+ * 		./omaros_rta tasks.csv [-c SysTickClockHz] [-m MeasuredMargin] [-s Horizon]
+ *
+ * Input file, one record per line, '#' starts a comment, times are in microseconds:
+ *
+ * 		mutex,<name>,<ceiling priority>				Mutex_ref.PriorityCeiling.Ceiling_Priority, '-' if disabled
+ * 		task,<name>,<priority>,<period>,<deadline>,<wcet>[,<mutex>:<critical section>]...
+ * 																deadline 0 = period
+ * 		measured,<task>,<cycles>					Task_ref.Stats.MaxJobTime (OMAROS_USE_RUNTIME_STATS)
+ *
+ * Measured job times are converted with the SysTick clock (-c, default 8000000) and multiplied by
+ * the margin (-m, default 1.0). The larger of the declared and the measured WCET is analysed.
+ *
+ * Like the kernel, a lower priority number is a higher priority. Tasks of equal priority share the
+ * CPU in round robin, so each one is counted as interference for the others.
+ *
+ * With -s the task set is also run for "Horizon" microseconds under both OMAROS_SCHEDULER_POLICY
+ * choices, every task released at time 0 then once per period, and the jobs that end after their
+ * deadline are counted per policy. A late job still runs to its end like in the kernel, the next
+ * jobs of the task wait for it. Jobs of equal priority run in release order (no time slice) and
+ * critical sections are not simulated, so it shows how the two policies behave on the same load,
+ * mostly past the bounds, while the analysis above is the guarantee.
+ *
+ * Exit code: 0 schedulable, 1 not schedulable, 2 invalid input
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+//----------------------------------------------
+// Section: Macros Configuration References
+//----------------------------------------------
+#define RTA_MAX_TASKS			128
+#define RTA_MAX_MUTEXES			32
+#define RTA_MAX_SECTIONS		8	/* Critical sections per task */
+#define RTA_MAX_NAME			32
+#define RTA_MAX_LINE			512
+#define RTA_NO_CEILING			(-1)
+
+//----------------------------------------------
+// Section: Type definitions
+//----------------------------------------------
+typedef struct{
+	char Name[RTA_MAX_NAME];
+	int  Ceiling;				/* RTA_NO_CEILING when priority ceiling is disabled */
+}RTA_Mutex;
+
+typedef struct{
+	int Mutex;					/* Index in the mutex table */
+	unsigned long long Length;	/* Longest time the mutex is held in one job */
+}RTA_Section;
+
+typedef struct{
+	char Name[RTA_MAX_NAME];
+	int  Priority;
+	unsigned long long Period;
+	unsigned long long Deadline;
+	unsigned long long Wcet;		/* Declared */
+	unsigned long long Measured;	/* Cycles, 0 if none */
+	unsigned long long C;			/* Analysed execution time */
+	unsigned long long Blocking;
+	unsigned long long Response;
+	int BlockingUnbounded;
+	int Schedulable;
+	RTA_Section Sections[RTA_MAX_SECTIONS];
+	int NoOfSections;
+}RTA_Task;
+
+/* State of a task during the simulation, its jobs run one after the other */
+typedef struct{
+	unsigned long long Released;	/* Jobs released so far */
+	unsigned long long Completed;	/* Jobs ended so far, the oldest pending job is number "Completed" */
+	unsigned long long Remaining;	/* Execution time left to the oldest pending job */
+	unsigned long long NextRelease;
+	unsigned long long Jobs;		/* Jobs with a deadline inside the horizon */
+	unsigned long long Misses;
+}RTA_SimTask;
+
+static RTA_Task  Tasks[RTA_MAX_TASKS];
+static RTA_Mutex Mutexes[RTA_MAX_MUTEXES];
+static int NoOfTasks, NoOfMutexes;
+
+//----------------------------------------------
+// Section: Input
+//----------------------------------------------
+static char* RTA_Trim(char* pStr){
+	char* pEnd;
+	while((*pStr == ' ') || (*pStr == '\t')){
+		pStr++;
+	}
+	pEnd = pStr + strlen(pStr);
+	while((pEnd > pStr) && ((pEnd[-1] == ' ') || (pEnd[-1] == '\t') || (pEnd[-1] == '\r') || (pEnd[-1] == '\n'))){
+		*--pEnd = '\0';
+	}
+	return pStr;
+}
+
+static int RTA_ParseULL(const char* pStr, unsigned long long* pValue){
+	char* pEnd;
+	if(*pStr == '\0'){
+		return 0;
+	}
+	*pValue = strtoull(pStr, &pEnd, 10);
+	return (*pEnd == '\0');
+}
+
+static int RTA_FindMutex(const char* pName){
+	int index;
+	for(index = 0; index < NoOfMutexes; index++){
+		if(strcmp(Mutexes[index].Name, pName) == 0){
+			return index;
+		}
+	}
+	return -1;
+}
+
+static int RTA_FindTask(const char* pName){
+	int index;
+	for(index = 0; index < NoOfTasks; index++){
+		if(strcmp(Tasks[index].Name, pName) == 0){
+			return index;
+		}
+	}
+	return -1;
+}
+
+/* Splits a line on commas in place, returns the number of fields */
+static int RTA_Split(char* pLine, char* Fields[], int MaxFields){
+	int count = 0;
+	char* pField = pLine;
+	char* pComma;
+
+	while(count < MaxFields){
+		pComma = strchr(pField, ',');
+		if(pComma != NULL){
+			*pComma = '\0';
+		}
+		Fields[count++] = RTA_Trim(pField);
+		if(pComma == NULL){
+			break;
+		}
+		pField = pComma + 1;
+	}
+	return count;
+}
+
+static int RTA_ParseTask(char* Fields[], int NoOfFields, int LineNo){
+	RTA_Task* pTask;
+	unsigned long long priority;
+	char* pColon;
+	int index;
+
+	if((NoOfFields < 6) || (NoOfTasks >= RTA_MAX_TASKS)){
+		fprintf(stderr, "line %d: expected task,<name>,<priority>,<period>,<deadline>,<wcet>[,<mutex>:<cs>]...\n", LineNo);
+		return 0;
+	}
+	pTask = &Tasks[NoOfTasks];
+	memset(pTask, 0, sizeof(*pTask));
+	strncpy(pTask->Name, Fields[1], RTA_MAX_NAME - 1);
+
+	if(!RTA_ParseULL(Fields[2], &priority) || (priority > 255) || !RTA_ParseULL(Fields[3], &pTask->Period) || (pTask->Period == 0)
+			|| !RTA_ParseULL(Fields[4], &pTask->Deadline) || !RTA_ParseULL(Fields[5], &pTask->Wcet)){
+		fprintf(stderr, "line %d: invalid number in task %s\n", LineNo, pTask->Name);
+		return 0;
+	}
+	pTask->Priority = (int)priority;
+	if(pTask->Deadline == 0){
+		pTask->Deadline = pTask->Period;
+	}
+
+	for(index = 6; index < NoOfFields; index++){
+		pColon = strchr(Fields[index], ':');
+		if((pColon == NULL) || (pTask->NoOfSections >= RTA_MAX_SECTIONS)){
+			fprintf(stderr, "line %d: expected <mutex>:<critical section>\n", LineNo);
+			return 0;
+		}
+		*pColon = '\0';
+		pTask->Sections[pTask->NoOfSections].Mutex = RTA_FindMutex(RTA_Trim(Fields[index]));
+		if(pTask->Sections[pTask->NoOfSections].Mutex < 0){
+			fprintf(stderr, "line %d: mutex %s must be declared before it is used\n", LineNo, Fields[index]);
+			return 0;
+		}
+		if(!RTA_ParseULL(RTA_Trim(pColon + 1), &pTask->Sections[pTask->NoOfSections].Length)){
+			fprintf(stderr, "line %d: invalid critical section length\n", LineNo);
+			return 0;
+		}
+		pTask->NoOfSections++;
+	}
+
+	NoOfTasks++;
+	return 1;
+}
+
+static int RTA_Load(const char* pPath){
+	char Line[RTA_MAX_LINE];
+	char* Fields[RTA_MAX_SECTIONS + 6];
+	char* pComment;
+	unsigned long long value;
+	int NoOfFields, LineNo = 0, index;
+	FILE* pFile = fopen(pPath, "r");
+
+	if(pFile == NULL){
+		perror(pPath);
+		return 0;
+	}
+
+	while(fgets(Line, sizeof(Line), pFile) != NULL){
+		LineNo++;
+		pComment = strchr(Line, '#');
+		if(pComment != NULL){
+			*pComment = '\0';
+		}
+		if(*RTA_Trim(Line) == '\0'){
+			continue;
+		}
+		NoOfFields = RTA_Split(RTA_Trim(Line), Fields, (int)(sizeof(Fields) / sizeof(Fields[0])));
+
+		if(strcmp(Fields[0], "task") == 0){
+			if(!RTA_ParseTask(Fields, NoOfFields, LineNo)){
+				fclose(pFile);
+				return 0;
+			}
+		}
+		else if((strcmp(Fields[0], "mutex") == 0) && (NoOfFields == 3) && (NoOfMutexes < RTA_MAX_MUTEXES)){
+			strncpy(Mutexes[NoOfMutexes].Name, Fields[1], RTA_MAX_NAME - 1);
+			if(strcmp(Fields[2], "-") == 0){
+				Mutexes[NoOfMutexes].Ceiling = RTA_NO_CEILING;
+			}
+			else if(RTA_ParseULL(Fields[2], &value) && (value <= 255)){
+				Mutexes[NoOfMutexes].Ceiling = (int)value;
+			}
+			else{
+				fprintf(stderr, "line %d: invalid ceiling priority\n", LineNo);
+				fclose(pFile);
+				return 0;
+			}
+			NoOfMutexes++;
+		}
+		else if((strcmp(Fields[0], "measured") == 0) && (NoOfFields == 3)){
+			index = RTA_FindTask(Fields[1]);
+			if((index < 0) || !RTA_ParseULL(Fields[2], &value)){
+				fprintf(stderr, "line %d: measured time needs a declared task and a cycle count\n", LineNo);
+				fclose(pFile);
+				return 0;
+			}
+			Tasks[index].Measured = value;
+		}
+		else{
+			fprintf(stderr, "line %d: unknown record \"%s\"\n", LineNo, Fields[0]);
+			fclose(pFile);
+			return 0;
+		}
+	}
+
+	fclose(pFile);
+	return 1;
+}
+
+//----------------------------------------------
+// Section: Analysis
+//----------------------------------------------
+
+/* Priority ceiling: task i waits for at most one critical section of a lower priority task,
+ * on a mutex whose ceiling is at least the priority of i */
+static void RTA_Blocking(RTA_Task* pTask){
+	int index, section;
+	RTA_Task* pLower;
+	RTA_Mutex* pMutex;
+
+	pTask->Blocking = 0;
+	for(index = 0; index < NoOfTasks; index++){
+		pLower = &Tasks[index];
+		if(pLower->Priority <= pTask->Priority){
+			continue;
+		}
+		for(section = 0; section < pLower->NoOfSections; section++){
+			pMutex = &Mutexes[pLower->Sections[section].Mutex];
+			if(pMutex->Ceiling == RTA_NO_CEILING){
+				/* Medium priority tasks can preempt the holder for as long as they run */
+				pTask->BlockingUnbounded = 1;
+			}
+			else if(pMutex->Ceiling > pTask->Priority){
+				continue;
+			}
+			if(pLower->Sections[section].Length > pTask->Blocking){
+				pTask->Blocking = pLower->Sections[section].Length;
+			}
+		}
+	}
+}
+
+/* R = C + B + sum over higher or equal priority tasks of ceil(R / Tj) * Cj */
+static void RTA_ResponseTime(RTA_Task* pTask){
+	unsigned long long Response = pTask->C + pTask->Blocking, Next;
+	int index;
+
+	while(1){
+		Next = pTask->C + pTask->Blocking;
+		for(index = 0; index < NoOfTasks; index++){
+			if((&Tasks[index] != pTask) && (Tasks[index].Priority <= pTask->Priority)){
+				Next += ((Response + Tasks[index].Period - 1) / Tasks[index].Period) * Tasks[index].C;
+			}
+		}
+		if((Next == Response) || (Next > pTask->Deadline)){
+			Response = Next;
+			break;
+		}
+		Response = Next;
+	}
+
+	pTask->Response = Response;
+	pTask->Schedulable = (Response <= pTask->Deadline) && !pTask->BlockingUnbounded;
+}
+
+//----------------------------------------------
+// Section: Simulation
+//----------------------------------------------
+#define RTA_POLICY_FIXED_PRIORITY	0
+#define RTA_POLICY_EDF				1
+
+/* Deadline of the oldest pending job of task "index" */
+#define RTA_SIM_DEADLINE(pSim, index)	(((pSim)[index].Completed * Tasks[index].Period) + Tasks[index].Deadline)
+
+/* Picks the task to run, or -1 if no job is pending. EDF keeps the running task on equal deadlines
+ * like OmarOS_DecideNextTask, fixed priority runs equal priorities in release order */
+static int RTA_SimPick(const RTA_SimTask* pSim, int Policy, int Running){
+	int index, Picked = -1;
+	unsigned long long Key, PickedKey = 0;
+
+	if((Policy == RTA_POLICY_EDF) && (Running >= 0) && (pSim[Running].Released > pSim[Running].Completed)){
+		Picked = Running;
+		PickedKey = RTA_SIM_DEADLINE(pSim, Running);
+	}
+	for(index = 0; index < NoOfTasks; index++){
+		if(pSim[index].Released == pSim[index].Completed){
+			continue;
+		}
+		if(Policy == RTA_POLICY_EDF){
+			Key = RTA_SIM_DEADLINE(pSim, index);
+			if((Picked < 0) || (Key < PickedKey)){
+				Picked = index;
+				PickedKey = Key;
+			}
+		}
+		else if((Picked < 0) || (Tasks[index].Priority < Tasks[Picked].Priority)
+				|| ((Tasks[index].Priority == Tasks[Picked].Priority)
+						&& ((pSim[index].Completed * Tasks[index].Period) < (pSim[Picked].Completed * Tasks[Picked].Period)))){
+			Picked = index;
+		}
+	}
+	return Picked;
+}
+
+/* Runs the task set from 0 to "Horizon", fills one RTA_SimTask per task */
+static void RTA_Simulate(RTA_SimTask* pSim, int Policy, unsigned long long Horizon){
+	unsigned long long Now = 0, NextEvent, Run;
+	int index, Running = -1;
+
+	memset(pSim, 0, sizeof(RTA_SimTask) * NoOfTasks);
+	while(Now < Horizon){
+		/* Release the jobs due now, a job without execution time ends right away */
+		for(index = 0; index < NoOfTasks; index++){
+			while(pSim[index].NextRelease <= Now){
+				if(pSim[index].Released == pSim[index].Completed){
+					pSim[index].Remaining = Tasks[index].C;
+				}
+				pSim[index].Released++;
+				pSim[index].NextRelease += Tasks[index].Period;
+			}
+			while((pSim[index].Released > pSim[index].Completed) && (pSim[index].Remaining == 0)){
+				pSim[index].Completed++;
+				pSim[index].Remaining = Tasks[index].C;
+			}
+		}
+
+		NextEvent = Horizon;
+		for(index = 0; index < NoOfTasks; index++){
+			if(pSim[index].NextRelease < NextEvent){
+				NextEvent = pSim[index].NextRelease;
+			}
+		}
+
+		Running = RTA_SimPick(pSim, Policy, Running);
+		if(Running < 0){
+			Now = NextEvent;
+			continue;
+		}
+
+		/* Run until the job ends or the next release, whichever comes first */
+		Run = NextEvent - Now;
+		if(pSim[Running].Remaining < Run){
+			Run = pSim[Running].Remaining;
+		}
+		pSim[Running].Remaining -= Run;
+		Now += Run;
+		if(pSim[Running].Remaining == 0){
+			if(Now > RTA_SIM_DEADLINE(pSim, Running)){
+				pSim[Running].Misses++;
+			}
+			pSim[Running].Jobs++;
+			pSim[Running].Completed++;
+			pSim[Running].Remaining = Tasks[Running].C;
+		}
+	}
+
+	/* Jobs still pending whose deadline passed are misses too */
+	for(index = 0; index < NoOfTasks; index++){
+		for(; pSim[index].Completed < pSim[index].Released; pSim[index].Completed++){
+			if(RTA_SIM_DEADLINE(pSim, index) <= Horizon){
+				pSim[index].Jobs++;
+				pSim[index].Misses++;
+			}
+		}
+	}
+}
+
+static void RTA_PrintSimulation(unsigned long long Horizon){
+	static RTA_SimTask FixedPriority[RTA_MAX_TASKS], Edf[RTA_MAX_TASKS];
+	unsigned long long Jobs[2] = { 0, 0 }, Misses[2] = { 0, 0 };
+	int index;
+
+	RTA_Simulate(FixedPriority, RTA_POLICY_FIXED_PRIORITY, Horizon);
+	RTA_Simulate(Edf, RTA_POLICY_EDF, Horizon);
+
+	printf("\nSimulation over %llu us\n", Horizon);
+	printf("%-25s %10s %10s %10s %10s\n", "Task", "FP jobs", "FP misses", "EDF jobs", "EDF misses");
+	for(index = 0; index < NoOfTasks; index++){
+		printf("%-25s %10llu %10llu %10llu %10llu\n", Tasks[index].Name, FixedPriority[index].Jobs, FixedPriority[index].Misses,
+				Edf[index].Jobs, Edf[index].Misses);
+		Jobs[0] += FixedPriority[index].Jobs;
+		Misses[0] += FixedPriority[index].Misses;
+		Jobs[1] += Edf[index].Jobs;
+		Misses[1] += Edf[index].Misses;
+	}
+	printf("%-25s %10llu %10llu %10llu %10llu\n", "Total", Jobs[0], Misses[0], Jobs[1], Misses[1]);
+	printf("%-25s %10s %9.2f%% %10s %9.2f%%\n", "Miss rate", "", (Jobs[0] != 0) ? (100.0 * (double)Misses[0] / (double)Jobs[0]) : 0.0, "",
+			(Jobs[1] != 0) ? (100.0 * (double)Misses[1] / (double)Jobs[1]) : 0.0);
+}
+
+int main(int argc, char* argv[]){
+	const char* pPath = NULL;
+	double ClockHz = 8000000.0, Margin = 1.0, MeasuredUs;
+	double Utilization = 0.0, Hyperbolic = 1.0, LiuLayland;
+	unsigned long long Horizon = 0;
+	int index, AllSchedulable = 1, ImplicitDeadlines = 1;
+
+	for(index = 1; index < argc; index++){
+		if((strcmp(argv[index], "-c") == 0) && ((index + 1) < argc)){
+			ClockHz = atof(argv[++index]);
+		}
+		else if((strcmp(argv[index], "-m") == 0) && ((index + 1) < argc)){
+			Margin = atof(argv[++index]);
+		}
+		else if((strcmp(argv[index], "-s") == 0) && ((index + 1) < argc)){
+			if(!RTA_ParseULL(argv[++index], &Horizon) || (Horizon == 0)){
+				pPath = NULL;
+				break;
+			}
+		}
+		else if(pPath == NULL){
+			pPath = argv[index];
+		}
+		else{
+			pPath = NULL;
+			break;
+		}
+	}
+	if((pPath == NULL) || (ClockHz <= 0.0) || (Margin <= 0.0)){
+		fprintf(stderr, "usage: %s <tasks.csv> [-c SysTickClockHz] [-m MeasuredMargin] [-s Horizon]\n", argv[0]);
+		return 2;
+	}
+	if(!RTA_Load(pPath) || (NoOfTasks == 0)){
+		if(NoOfTasks == 0){
+			fprintf(stderr, "%s: no tasks\n", pPath);
+		}
+		return 2;
+	}
+
+	for(index = 0; index < NoOfTasks; index++){
+		Tasks[index].C = Tasks[index].Wcet;
+		if(Tasks[index].Measured != 0){
+			MeasuredUs = ceil(((double)Tasks[index].Measured * 1000000.0 / ClockHz) * Margin);
+			if((unsigned long long)MeasuredUs > Tasks[index].C){
+				Tasks[index].C = (unsigned long long)MeasuredUs;
+			}
+		}
+		Utilization += (double)Tasks[index].C / (double)Tasks[index].Period;
+		Hyperbolic *= ((double)Tasks[index].C / (double)Tasks[index].Period) + 1.0;
+		if(Tasks[index].Deadline != Tasks[index].Period){
+			ImplicitDeadlines = 0;
+		}
+	}
+	for(index = 0; index < NoOfTasks; index++){
+		RTA_Blocking(&Tasks[index]);
+		RTA_ResponseTime(&Tasks[index]);
+		AllSchedulable &= Tasks[index].Schedulable;
+	}
+
+	printf("%-20s %4s %10s %10s %10s %10s %10s %10s  %s\n", "Task", "Prio", "Period", "Deadline", "C", "C meas.", "Blocking", "Response", "Result");
+	for(index = 0; index < NoOfTasks; index++){
+		RTA_Task* pTask = &Tasks[index];
+		if(pTask->Measured != 0){
+			printf("%-20s %4d %10llu %10llu %10llu %10.0f %10llu %10llu  %s\n", pTask->Name, pTask->Priority, pTask->Period, pTask->Deadline,
+					pTask->C, (double)pTask->Measured * 1000000.0 / ClockHz, pTask->Blocking, pTask->Response,
+					pTask->BlockingUnbounded ? "UNBOUNDED BLOCKING" : (pTask->Schedulable ? "ok" : "DEADLINE MISS"));
+		}
+		else{
+			printf("%-20s %4d %10llu %10llu %10llu %10s %10llu %10llu  %s\n", pTask->Name, pTask->Priority, pTask->Period, pTask->Deadline,
+					pTask->C, "-", pTask->Blocking, pTask->Response,
+					pTask->BlockingUnbounded ? "UNBOUNDED BLOCKING" : (pTask->Schedulable ? "ok" : "DEADLINE MISS"));
+		}
+	}
+
+	LiuLayland = NoOfTasks * (pow(2.0, 1.0 / NoOfTasks) - 1.0);
+	printf("\nUtilization            : %.4f\n", Utilization);
+	printf("Liu & Layland bound    : %.4f (%s)\n", LiuLayland, (Utilization <= LiuLayland) ? "met" : "not met, see the response times");
+	printf("Hyperbolic bound       : %.4f <= 2 (%s)\n", Hyperbolic, (Hyperbolic <= 2.0) ? "met" : "not met, see the response times");
+	if(ImplicitDeadlines){
+		printf("EDF (deadline = period): %s\n", (Utilization <= 1.0) ? "schedulable, U <= 1" : "overloaded, U > 1");
+	}
+	printf("Response time analysis : %s\n", AllSchedulable ? "all deadlines met" : "NOT schedulable");
+
+	if(Horizon != 0){
+		RTA_PrintSimulation(Horizon);
+	}
+
+	return AllSchedulable ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : String_Library                                    	 */
+/* File          : OmarOS_SearchBench.c 		                         */
+/* Date          : Jun 22, 2023                                          */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+/*
+ * =============================================
+ * String search benchmark (host tool)
+ * =============================================
+ *
+ * Times the Boyer-Moore-Horspool searches of string_lib against the loops they replaced, across
+ * text and word sizes. Build and run on the host:
+ *
+ * 		gcc -O2 -IOmarOS/Inc -o omaros_searchbench Tools/OmarOS_SearchBench.c OmarOS/string_lib.c
+ * 		./omaros_searchbench [-m Megabytes]
+ *
+ * The V1 loops are kept as they were apart from the indexes: V1 used unsigned short and stopped at
+ * 65535 characters, here they are unsigned long so they run on the larger texts. For every start
+ * position they compare the whole word, a mismatch doesn't end the comparison.
+ *
+ * The text is random lower case letters and spaces, without 'z'. The word starts with 'z', so it is
+ * never found and every search reads the whole text (V1 can't report a word cut off by the end).
+ * Columns:
+ * 		V1 first		V1 STRING_word_firstOccurrence
+ * 		V1 last			V1 STRING_word_lastOccurrence (always scans to the end)
+ * 		first			STRING_word_firstOccurrence
+ * 		last			STRING_word_lastOccurrence
+ * 		memory			STRING_memory_search with both lengths known
+ *
+ * Every search returns NULL, this is checked. Results are in MB/s of text searched on the host, each
+ * cell searches at least "Megabytes" (8 by default), they are not target figures.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "string_lib.h"
+
+//----------------------------------------------
+// Section: Macros Configuration References
+//----------------------------------------------
+#define BENCH_MEGABYTES			8UL
+#define BENCH_MAX_TEXT			(1UL << 20)
+#define BENCH_MAX_WORD			32
+
+static const unsigned long Bench_TextSizes[] = { 256, 4096, 65536, BENCH_MAX_TEXT };
+static const unsigned long Bench_WordSizes[] = { 2, 8, BENCH_MAX_WORD };
+
+//----------------------------------------------
+// Section: V1 searches
+//----------------------------------------------
+static unsigned char* V1_word_firstOccurrence(const unsigned char* str, const unsigned char* word){
+	unsigned char* ret_val = NULL;
+
+	/* Validate that we are not accessing a null pointer */
+	if( (NULL != str) && (NULL != word) ){
+		unsigned long str_index = 0;
+		unsigned long word_index;
+		while('\0' != str[str_index]){
+			/* Reset flag */
+			unsigned int found_flag = 0;
+			for(word_index = 0; ( ('\0' != word[word_index]) && ('\0' != str[str_index + word_index]) ) ; word_index++){
+				/* If characters are not equal, set a flag */
+				if(str[str_index + word_index] != word[word_index]){
+					found_flag |= 1;
+				}
+				else{ /* Do Nothing */ }
+			}
+			if(0 == found_flag){
+				/* If found, set return value and break while loop */
+				ret_val = (unsigned char*)&(str[str_index]);
+				break;
+			}
+			else{ /* Do Nothing */ }
+			str_index++;
+		}
+	}
+	else{ /* Do Nothing */ }
+	return ret_val;
+}
+
+static unsigned char* V1_word_lastOccurrence(const unsigned char* str, const unsigned char* word){
+	unsigned char* ret_val = NULL;
+
+	/* Validate that we are not accessing a null pointer */
+	if( (NULL != str) && (NULL != word) ){
+		unsigned long str_index = 0;
+		unsigned long word_index;
+		while('\0' != str[str_index]){
+			/* Reset flag */
+			unsigned int found_flag = 0;
+			for(word_index = 0; ( ('\0' != word[word_index]) && ('\0' != str[str_index + word_index]) ) ; word_index++){
+				/* If characters are not equal, set a flag */
+				if(str[str_index + word_index] != word[word_index]){
+					found_flag |= 1;
+				}
+				else{ /* Do Nothing */ }
+			}
+			if(0 == found_flag){
+				/* If found, set return value and continue to check if there is one more occurence */
+				ret_val = (unsigned char*)&(str[str_index]);
+			}
+			else{ /* Do Nothing */ }
+			str_index++;
+		}
+	}
+	else{ /* Do Nothing */ }
+	return ret_val;
+}
+
+//----------------------------------------------
+// Section: Workloads
+//----------------------------------------------
+typedef unsigned char* (*Bench_search)(const unsigned char* str, const unsigned char* word);
+
+static unsigned char Text[BENCH_MAX_TEXT + 1];
+static unsigned char Word[BENCH_MAX_WORD + 1];
+static unsigned long Found;
+
+static double Bench_Now(void){
+	struct timespec Now;
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+static void Bench_MakeText(void){
+	static const char Letters[] = "abcdefghijklmnopqrstuvwxy     ";
+	unsigned int Seed = 1;
+	unsigned long index;
+
+	for(index = 0; index < BENCH_MAX_TEXT; index++){
+		Seed = (Seed * 1103515245U) + 12345U;
+		Text[index] = (unsigned char)Letters[(Seed >> 16) % (sizeof(Letters) - 1)];
+	}
+	for(index = 1; index < BENCH_MAX_WORD; index++){
+		Seed = (Seed * 1103515245U) + 12345U;
+		Word[index] = (unsigned char)Letters[(Seed >> 16) % 25];
+	}
+	Word[0] = 'z';
+}
+
+/* MB/s over a text of "Size" characters, Text[Size] and Word[Length] are the terminating nulls */
+static double Bench_String(Bench_search pfSearch, unsigned long Size, unsigned long Megabytes){
+	unsigned long loop, Loops = ((Megabytes << 20) + Size - 1) / Size;
+	double Start = Bench_Now();
+
+	for(loop = 0; loop < Loops; loop++){
+		if(NULL != pfSearch(Text, Word)){
+			Found++;
+		}
+	}
+	return ((double)Loops * Size / (1024.0 * 1024.0)) / ((Bench_Now() - Start) / 1e9);
+}
+
+static double Bench_Memory(unsigned long Size, unsigned long Length, unsigned long Megabytes){
+	unsigned long loop, Loops = ((Megabytes << 20) + Size - 1) / Size;
+	double Start = Bench_Now();
+
+	for(loop = 0; loop < Loops; loop++){
+		if(NULL != STRING_memory_search(Text, Size, Word, Length)){
+			Found++;
+		}
+	}
+	return ((double)Loops * Size / (1024.0 * 1024.0)) / ((Bench_Now() - Start) / 1e9);
+}
+
+//----------------------------------------------
+// Section: Main
+//----------------------------------------------
+int main(int argc, char* argv[]){
+	unsigned long Megabytes = BENCH_MEGABYTES;
+	unsigned long Size, Length;
+	unsigned int text, word;
+	unsigned char Saved;
+
+	if((argc == 3) && (strcmp(argv[1], "-m") == 0) && (atol(argv[2]) > 0)){
+		Megabytes = (unsigned long)atol(argv[2]);
+	}
+	else if(argc != 1){
+		fprintf(stderr, "usage: %s [-m Megabytes]\n", argv[0]);
+		return 2;
+	}
+
+	Bench_MakeText();
+
+	printf("%-8s %5s %10s %10s %10s %10s %10s\n", "Text", "Word", "V1 first", "V1 last", "first", "last", "memory");
+	for(text = 0; text < (sizeof(Bench_TextSizes) / sizeof(Bench_TextSizes[0])); text++){
+		Size = Bench_TextSizes[text];
+		Saved = Text[Size];
+		Text[Size] = '\0';
+		for(word = 0; word < (sizeof(Bench_WordSizes) / sizeof(Bench_WordSizes[0])); word++){
+			Length = Bench_WordSizes[word];
+			Word[Length] = '\0';
+			printf("%-8lu %5lu", Size, Length);
+			printf(" %10.0f", Bench_String(V1_word_firstOccurrence, Size, Megabytes));
+			printf(" %10.0f", Bench_String(V1_word_lastOccurrence, Size, Megabytes));
+			printf(" %10.0f", Bench_String(STRING_word_firstOccurrence, Size, Megabytes));
+			printf(" %10.0f", Bench_String(STRING_word_lastOccurrence, Size, Megabytes));
+			printf(" %10.0f\n", Bench_Memory(Size, Length, Megabytes));
+			fflush(stdout);
+			Word[Length] = 'a';
+		}
+		Text[Size] = Saved;
+	}
+
+	if(Found != 0){
+		fprintf(stderr, "%lu searches found a word that is not in the text\n", Found);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,191 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : String_Library                                    	 */
+/* File          : OmarOS_TokenizerBench.c 		                         */
+/* Date          : Jun 22, 2023                                          */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+/*
+ * =============================================
+ * String tokenizer benchmark (host tool)
+ * =============================================
+ *
+ * Splits NMEA GGA sentences on ",*" three ways and prints the throughput of each. Build and run
+ * on the host:
+ *
+ * 		gcc -O2 -IOmarOS/Inc -o omaros_tokenizerbench Tools/OmarOS_TokenizerBench.c \
+ * 			OmarOS/string_tokenizer.c OmarOS/string_view.c OmarOS/string_lib.c
+ * 		./omaros_tokenizerbench [-m Megabytes]
+ *
+ * Workloads, over the same sentences (8 MB by default):
+ * 		tokenizer		STRING_tokenizer_next over each line, line ends are found before timing
+ * 		stream			STRING_stream_push with the whole buffer in 256 bytes chunks, "\r\n" ends a record
+ * 		firstOccurrence	STRING_char_firstOccurrence for ',' and '*' then STRING_length for the last field,
+ * 						how lines were split before the tokenizer (every field rescans the rest of the line)
+ *
+ * Every workload adds up the field lengths, the totals are checked against each other. Results are
+ * in MB/s of sentence text on the host and are not target figures.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "string_tokenizer.h"
+
+//----------------------------------------------
+// Section: Macros Configuration References
+//----------------------------------------------
+#define BENCH_MEGABYTES			8UL
+#define BENCH_CHUNK				256
+#define BENCH_RECORD_SIZE		128
+
+//----------------------------------------------
+// Section: Sentences
+//----------------------------------------------
+static unsigned char* Text;			/* Sentences with "\r\n" line endings */
+static unsigned char* Strings;		/* Same sentences, each one null terminated */
+static size_t TextLength;
+static size_t* LineStart;
+static size_t* LineLength;
+static size_t NoOfLines;
+static STRING_delimiters Delimiters, Terminators;
+
+static double Bench_Now(void){
+	struct timespec Now;
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+static void Bench_MakeSentences(size_t Size){
+	char Line[BENCH_RECORD_SIZE];
+	size_t Length, Lines = 0;
+	unsigned long Second = 0;
+
+	Text = malloc(Size + BENCH_RECORD_SIZE);
+	Strings = malloc(Size + BENCH_RECORD_SIZE);
+	LineStart = malloc(((Size / 32) + 1) * sizeof(size_t));
+	LineLength = malloc(((Size / 32) + 1) * sizeof(size_t));
+	if((NULL == Text) || (NULL == Strings) || (NULL == LineStart) || (NULL == LineLength)){
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+
+	while(TextLength < Size){
+		Length = (size_t)snprintf(Line, sizeof(Line), "$GPGGA,%02lu%02lu%02lu.00,4807.%03lu,N,01131.%03lu,E,1,%02lu,0.9,%lu.4,M,46.9,M,,*%02lX",
+				(Second / 3600) % 24, (Second / 60) % 60, Second % 60, Second % 1000, (Second * 7) % 1000,
+				4 + (Second % 9), 500 + (Second % 100), Second & 0xFF);
+		LineStart[Lines] = TextLength;
+		LineLength[Lines] = Length;
+		memcpy(&Text[TextLength], Line, Length);
+		memcpy(&Strings[TextLength], Line, Length);
+		Text[TextLength + Length] = '\r';
+		Text[TextLength + Length + 1] = '\n';
+		Strings[TextLength + Length] = '\0';
+		Strings[TextLength + Length + 1] = '\0';
+		TextLength += Length + 2;
+		Lines++;
+		Second++;
+	}
+	NoOfLines = Lines;
+}
+
+//----------------------------------------------
+// Section: Workloads
+//----------------------------------------------
+static double Bench_Tokenizer(size_t* pTotal){
+	STRING_tokenizer Tokenizer;
+	STRING_field Field;
+	size_t Line, Total = 0;
+	double Start = Bench_Now();
+
+	for(Line = 0; Line < NoOfLines; Line++){
+		STRING_tokenizer_init(&Tokenizer, &Text[LineStart[Line]], LineLength[Line], &Delimiters, 0);
+		while(STRING_tokenizer_next(&Tokenizer, &Field)){
+			Total += Field.Length;
+		}
+	}
+	*pTotal = Total;
+	return Bench_Now() - Start;
+}
+
+static void Bench_StreamField(void* pContext, const unsigned char* pRecord, const STRING_field* pField){
+	(void)pRecord;
+	*(size_t*)pContext += pField->Length;
+}
+
+static double Bench_Stream(size_t* pTotal){
+	STRING_stream_tokenizer Stream;
+	unsigned char Record[BENCH_RECORD_SIZE];
+	size_t Offset, Total = 0;
+	double Start = Bench_Now();
+
+	STRING_stream_init(&Stream, Record, sizeof(Record), &Delimiters, &Terminators, 0, Bench_StreamField, &Total);
+	for(Offset = 0; Offset < TextLength; Offset += BENCH_CHUNK){
+		STRING_stream_push(&Stream, &Text[Offset], ((TextLength - Offset) < BENCH_CHUNK) ? (TextLength - Offset) : BENCH_CHUNK);
+	}
+	*pTotal = Total;
+	return Bench_Now() - Start;
+}
+
+static double Bench_FirstOccurrence(size_t* pTotal){
+	const unsigned char *pField, *pComma, *pStar, *pEnd;
+	size_t Line, Total = 0;
+	double Start = Bench_Now();
+
+	for(Line = 0; Line < NoOfLines; Line++){
+		pField = &Strings[LineStart[Line]];
+		while(1){
+			pComma = STRING_char_firstOccurrence(pField, ',');
+			pStar = STRING_char_firstOccurrence(pField, '*');
+			pEnd = ((NULL == pComma) || ((NULL != pStar) && (pStar < pComma))) ? pStar : pComma;
+			if(NULL == pEnd){
+				Total += STRING_length(pField);
+				break;
+			}
+			Total += (size_t)(pEnd - pField);
+			pField = pEnd + 1;
+		}
+	}
+	*pTotal = Total;
+	return Bench_Now() - Start;
+}
+
+//----------------------------------------------
+// Section: Main
+//----------------------------------------------
+int main(int argc, char* argv[]){
+	unsigned long Megabytes = BENCH_MEGABYTES;
+	size_t Tokenizer, Stream, FirstOccurrence;
+	double MB, Time;
+
+	if((argc == 3) && (strcmp(argv[1], "-m") == 0) && (atol(argv[2]) > 0)){
+		Megabytes = (unsigned long)atol(argv[2]);
+	}
+	else if(argc != 1){
+		fprintf(stderr, "usage: %s [-m Megabytes]\n", argv[0]);
+		return 2;
+	}
+
+	STRING_delimiters_init(&Delimiters, (const unsigned char*)",*");
+	STRING_delimiters_init(&Terminators, (const unsigned char*)"\r\n");
+	Bench_MakeSentences(Megabytes << 20);
+	MB = (double)TextLength / (1024.0 * 1024.0);
+
+	printf("%lu lines, %.1f MB\n", (unsigned long)NoOfLines, MB);
+	printf("%-16s %10s\n", "Workload", "MB/s");
+	Time = Bench_Tokenizer(&Tokenizer);
+	printf("%-16s %10.0f\n", "tokenizer", MB / (Time / 1e9));
+	Time = Bench_Stream(&Stream);
+	printf("%-16s %10.0f\n", "stream", MB / (Time / 1e9));
+	Time = Bench_FirstOccurrence(&FirstOccurrence);
+	printf("%-16s %10.0f\n", "firstOccurrence", MB / (Time / 1e9));
+
+	if((Tokenizer != Stream) || (Tokenizer != FirstOccurrence)){
+		fprintf(stderr, "field lengths differ: %lu %lu %lu\n", (unsigned long)Tokenizer, (unsigned long)Stream, (unsigned long)FirstOccurrence);
+		return 1;
+	}
+	return 0;
+}
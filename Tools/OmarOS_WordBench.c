@@ -0,0 +1,250 @@
+/*************************************************************************/
+/* Author        : Omar Yamany                                    		 */
+/* Project       : String_Library                                    	 */
+/* File          : OmarOS_WordBench.c 			                         */
+/* Date          : Jun 22, 2023                                          */
+/* Version       : V1                                                    */
+/* GitHub        : https://github.com/Piistachyoo             		     */
+/*************************************************************************/
+
+/*
+ * =============================================
+ * String word at a time benchmark (host tool)
+ * =============================================
+ *
+ * Builds string_lib.c twice, with STRING_WORD_AT_A_TIME 0 and 1, and times the string functions
+ * that have a word path in both builds. Build and run on the host:
+ *
+ * 		gcc -O2 -fno-tree-loop-distribute-patterns -IOmarOS/Inc -o omaros_wordbench Tools/OmarOS_WordBench.c
+ * 		./omaros_wordbench [-m Megabytes]
+ *
+ * The byte build gets a Byte_ prefix on every name string_lib.c defines. Without
+ * -fno-tree-loop-distribute-patterns GCC replaces some byte loops (STRING_set_memoryLocation) with
+ * calls to the host C library, which is not what runs on the target. A host word is 8 bytes, the
+ * target's is 4, so the host gains more per word than the Cortex-M3 will.
+ *
+ * Strings are random letters of both cases, word aligned and null terminated. Workloads:
+ * 		length			STRING_length
+ * 		copy			STRING_copy
+ * 		compare			STRING_compare_caseSensitive of two equal strings
+ * 		compare_ci		STRING_compare_caseInsensitive of a string and its lower case copy
+ * 		lowerCase		STRING_convert_lowerCase then STRING_convert_upperCase, counted as two passes
+ * 		set				STRING_set_memoryLocation
+ *
+ * Every workload checks its results. Results are in bytes per nanosecond on the host, each cell
+ * handles at least "Megabytes" (8 by default). They are not target figures: on the target time the
+ * same calls with the DWT cycle counter (DWT->CYCCNT).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//----------------------------------------------
+// Section: Byte at a time build
+//----------------------------------------------
+#define STRING_WORD_AT_A_TIME							0
+#define STRING_convert_upperCase						Byte_STRING_convert_upperCase
+#define STRING_convert_lowerCase						Byte_STRING_convert_lowerCase
+#define STRING_set_memoryLocation						Byte_STRING_set_memoryLocation
+#define STRING_concatenate								Byte_STRING_concatenate
+#define STRING_concatenate_length						Byte_STRING_concatenate_length
+#define STRING_char_firstOccurrence						Byte_STRING_char_firstOccurrence
+#define STRING_char_lastOccurrence						Byte_STRING_char_lastOccurrence
+#define STRING_compare_caseSensitive					Byte_STRING_compare_caseSensitive
+#define STRING_compare_caseInsensitive					Byte_STRING_compare_caseInsensitive
+#define STRING_compare_caseSensitive_length				Byte_STRING_compare_caseSensitive_length
+#define STRING_compare_caseInsensitive_length			Byte_STRING_compare_caseInsensitive_length
+#define STRING_copy										Byte_STRING_copy
+#define STRING_copy_length								Byte_STRING_copy_length
+#define STRING_length									Byte_STRING_length
+#define STRING_word_firstOccurrence						Byte_STRING_word_firstOccurrence
+#define STRING_word_lastOccurrence						Byte_STRING_word_lastOccurrence
+#define STRING_word_firstOccurrence_caseInsensitive		Byte_STRING_word_firstOccurrence_caseInsensitive
+#define STRING_memory_copy								Byte_STRING_memory_copy
+#define STRING_memory_move								Byte_STRING_memory_move
+#define STRING_memory_compare							Byte_STRING_memory_compare
+#define STRING_memory_search							Byte_STRING_memory_search
+#define STRING_lower_table								Byte_STRING_lower_table
+#define STRING_upper_table								Byte_STRING_upper_table
+#define STRING_measure									Byte_STRING_measure
+#define STRING_equal									Byte_STRING_equal
+#define STRING_search									Byte_STRING_search
+#include "../OmarOS/string_lib.c"
+#undef STRING_WORD_AT_A_TIME
+#undef STRING_convert_upperCase
+#undef STRING_convert_lowerCase
+#undef STRING_set_memoryLocation
+#undef STRING_concatenate
+#undef STRING_concatenate_length
+#undef STRING_char_firstOccurrence
+#undef STRING_char_lastOccurrence
+#undef STRING_compare_caseSensitive
+#undef STRING_compare_caseInsensitive
+#undef STRING_compare_caseSensitive_length
+#undef STRING_compare_caseInsensitive_length
+#undef STRING_copy
+#undef STRING_copy_length
+#undef STRING_length
+#undef STRING_word_firstOccurrence
+#undef STRING_word_lastOccurrence
+#undef STRING_word_firstOccurrence_caseInsensitive
+#undef STRING_memory_copy
+#undef STRING_memory_move
+#undef STRING_memory_compare
+#undef STRING_memory_search
+#undef STRING_lower_table
+#undef STRING_upper_table
+#undef STRING_measure
+#undef STRING_equal
+#undef STRING_search
+
+//----------------------------------------------
+// Section: Word at a time build
+//----------------------------------------------
+#define STRING_WORD_AT_A_TIME							1
+#include "../OmarOS/string_lib.c"
+
+//----------------------------------------------
+// Section: Macros Configuration References
+//----------------------------------------------
+#define BENCH_MEGABYTES			8UL
+#define BENCH_MAX_SIZE			4096
+
+static const unsigned long Bench_Sizes[] = { 16, 64, 256, BENCH_MAX_SIZE };
+
+//----------------------------------------------
+// Section: Workloads
+//----------------------------------------------
+typedef struct{
+	unsigned short (*pfLength)(const unsigned char* str);
+	unsigned short (*pfCopy)(const unsigned char* src_str, unsigned char* des_str);
+	signed char (*pfCompare)(const unsigned char* str1, const unsigned char* str2);
+	signed char (*pfCompareCI)(const unsigned char* str1, const unsigned char* str2);
+	void (*pfLower)(unsigned char* str);
+	void (*pfUpper)(unsigned char* str);
+	void (*pfSet)(unsigned char* str, unsigned char value, unsigned short size);
+}Bench_build;
+
+static const Bench_build Bench_Byte = {
+	Byte_STRING_length, Byte_STRING_copy, Byte_STRING_compare_caseSensitive, Byte_STRING_compare_caseInsensitive,
+	Byte_STRING_convert_lowerCase, Byte_STRING_convert_upperCase, Byte_STRING_set_memoryLocation
+};
+
+static const Bench_build Bench_Word = {
+	STRING_length, STRING_copy, STRING_compare_caseSensitive, STRING_compare_caseInsensitive,
+	STRING_convert_lowerCase, STRING_convert_upperCase, STRING_set_memoryLocation
+};
+
+static unsigned long __attribute__((aligned(8))) Src_Words[(BENCH_MAX_SIZE / sizeof(unsigned long)) + 1];
+static unsigned long __attribute__((aligned(8))) Des_Words[(BENCH_MAX_SIZE / sizeof(unsigned long)) + 1];
+static unsigned long __attribute__((aligned(8))) Lower_Words[(BENCH_MAX_SIZE / sizeof(unsigned long)) + 1];
+static unsigned char* const Src = (unsigned char*)Src_Words;
+static unsigned char* const Des = (unsigned char*)Des_Words;
+static unsigned char* const Lower = (unsigned char*)Lower_Words;
+static unsigned long Errors;
+
+static double Bench_Now(void){
+	struct timespec Now;
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+/* Random letters of both cases, "Lower" gets the same string in lower case */
+static void Bench_MakeStrings(unsigned long Size){
+	unsigned int Seed = 1;
+	unsigned long index;
+
+	for(index = 0; index < Size; index++){
+		Seed = (Seed * 1103515245U) + 12345U;
+		Src[index] = (unsigned char)(((Seed >> 16) & 0x20) | ('A' + ((Seed >> 17) % 26)));
+		Lower[index] = (unsigned char)(Src[index] | 0x20);
+	}
+	Src[Size] = '\0';
+	Lower[Size] = '\0';
+}
+
+/* Bytes per ns of one workload, "Passes" strings of "Size" bytes are handled per loop */
+static double Bench_Run(const Bench_build* pBuild, unsigned int Workload, unsigned long Size, unsigned long Megabytes){
+	unsigned long loop, Loops = ((Megabytes << 20) + Size - 1) / Size;
+	unsigned long Passes = 1;
+	double Start;
+
+	Bench_MakeStrings(Size);
+	memcpy(Des, Src, Size + 1);
+	Start = Bench_Now();
+	for(loop = 0; loop < Loops; loop++){
+		switch(Workload){
+		case 0:
+			Errors += (pBuild->pfLength(Src) != Size);
+			break;
+		case 1:
+			Errors += (pBuild->pfCopy(Src, Des) != Size);
+			break;
+		case 2:
+			Errors += (pBuild->pfCompare(Src, Des) != 0);
+			break;
+		case 3:
+			Errors += (pBuild->pfCompareCI(Src, Lower) != 0);
+			break;
+		case 4:
+			pBuild->pfLower(Des);
+			pBuild->pfUpper(Des);
+			Passes = 2;
+			break;
+		default:
+			pBuild->pfSet(Des, (unsigned char)loop, (unsigned short)Size);
+			break;
+		}
+	}
+	Start = Bench_Now() - Start;
+
+	/* Checks what the loop left behind */
+	if(4 == Workload){
+		pBuild->pfLower(Des);
+		Errors += (memcmp(Des, Lower, Size + 1) != 0);
+	}
+	else if(5 == Workload){
+		Errors += (Des[0] != (unsigned char)(Loops - 1)) || (Des[Size - 1] != (unsigned char)(Loops - 1)) || (Des[Size] != '\0');
+	}
+	else if(1 == Workload){
+		Errors += (memcmp(Des, Src, Size + 1) != 0);
+	}
+	else{ /* Do Nothing */ }
+
+	return ((double)Loops * Passes * Size) / Start;
+}
+
+//----------------------------------------------
+// Section: Main
+//----------------------------------------------
+int main(int argc, char* argv[]){
+	static const char* const Names[] = { "length", "copy", "compare", "compare_ci", "lowerCase", "set" };
+	unsigned long Megabytes = BENCH_MEGABYTES;
+	unsigned int Workload, size;
+	double Byte, Word;
+
+	if((argc == 3) && (strcmp(argv[1], "-m") == 0) && (atol(argv[2]) > 0)){
+		Megabytes = (unsigned long)atol(argv[2]);
+	}
+	else if(argc != 1){
+		fprintf(stderr, "usage: %s [-m Megabytes]\n", argv[0]);
+		return 2;
+	}
+
+	printf("%-12s %6s %10s %10s %8s\n", "Workload", "Size", "Byte B/ns", "Word B/ns", "Speedup");
+	for(Workload = 0; Workload < (sizeof(Names) / sizeof(Names[0])); Workload++){
+		for(size = 0; size < (sizeof(Bench_Sizes) / sizeof(Bench_Sizes[0])); size++){
+			Byte = Bench_Run(&Bench_Byte, Workload, Bench_Sizes[size], Megabytes);
+			Word = Bench_Run(&Bench_Word, Workload, Bench_Sizes[size], Megabytes);
+			printf("%-12s %6lu %10.2f %10.2f %7.2fx\n", Names[Workload], Bench_Sizes[size], Byte, Word, Word / Byte);
+		}
+	}
+
+	if(Errors != 0){
+		fprintf(stderr, "%lu wrong results\n", Errors);
+		return 1;
+	}
+	return 0;
+}